@@ -0,0 +1,184 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../ECS/ecs.hpp"
+
+namespace
+{
+constexpr size_t ENTITY_COUNT = 20000;
+constexpr float WORLD_SIZE = 4000.f;
+constexpr float CELL_SIZE = 32.f;
+constexpr size_t FRAMES = 200;
+
+struct Position
+{
+	float x, y;
+};
+
+struct Velocity
+{
+	float x, y;
+};
+
+struct Collider
+{
+	float radius;
+	size_t hits = 0;
+};
+
+/**
+ * @brief  ,   .
+ */
+struct Grid
+{
+	static constexpr int SIDE = static_cast<int>(WORLD_SIZE / CELL_SIZE) + 1;
+
+	std::vector<std::vector<Position*>> cells = std::vector<std::vector<Position*>>(SIDE * SIDE);
+
+	std::vector<Position*>* at(int x, int y)
+	{
+		if (x < 0 || y < 0 || x >= SIDE || y >= SIDE)
+		{
+			return nullptr;
+		}
+		return &cells[y * SIDE + x];
+	}
+};
+
+void Move(ecs::context& ctx, Position& position, Velocity& velocity)
+{
+	position.x += velocity.x * ctx.delta_time;
+	position.y += velocity.y * ctx.delta_time;
+}
+
+void ClearGrid(ecs::context& ctx)
+{
+	for (auto& cell : ctx.resource<Grid>().cells)
+	{
+		cell.clear();
+	}
+}
+
+void FillGrid(ecs::context& ctx, Position& position)
+{
+	auto x = static_cast<int>(position.x / CELL_SIZE);
+	auto y = static_cast<int>(position.y / CELL_SIZE);
+	if (auto cell = ctx.resource<Grid>().at(x, y))
+	{
+		cell->push_back(&position);
+	}
+}
+
+void Collide(ecs::context& ctx, Position& position, Collider& collider)
+{
+	auto& grid = ctx.resource<Grid>();
+	auto cx = static_cast<int>(position.x / CELL_SIZE);
+	auto cy = static_cast<int>(position.y / CELL_SIZE);
+	for (int dx = -1; dx <= 1; ++dx)
+	{
+		for (int dy = -1; dy <= 1; ++dy)
+		{
+			auto cell = grid.at(cx + dx, cy + dy);
+			if (!cell)
+				continue;
+
+			for (auto other : *cell)
+			{
+				auto x = other->x - position.x;
+				auto y = other->y - position.y;
+				if (other != &position && x * x + y * y < collider.radius * collider.radius)
+				{
+					++collider.hits;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief      .
+ * @brief      ,
+ * @brief      ,    .
+ */
+void Spawn(ecs::entity_manager& em)
+{
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> coord(0.f, WORLD_SIZE);
+	std::uniform_real_distribution<float> speed(-20.f, 20.f);
+	std::vector<std::unique_ptr<char[]>> noise;
+	for (size_t i = 0; i < ENTITY_COUNT; ++i)
+	{
+		em.create()
+			.add<Position>(coord(random), coord(random))
+			.add<Velocity>(speed(random), speed(random))
+			.add<Collider>(8.f);
+		noise.push_back(std::make_unique<char[]>(64 + random() % 192));
+		if (noise.size() > 64)
+		{
+			noise.erase(noise.begin() + random() % noise.size());
+		}
+	}
+}
+
+double MeasureFrames(ecs::looper& looper, size_t frames)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < frames; ++i)
+	{
+		looper.frame(1.f / 60.f);
+	}
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / frames;
+}
+} // namespace
+
+int main()
+{
+	ecs::entity_manager em;
+	ecs::system_manager sm(em);
+	ecs::looper looper(sm);
+
+	Spawn(em);
+	sm.context().set_resource<Grid>();
+
+	bool defragment = false;
+	ecs::defragmenter<Position, Velocity, Collider> defragmenter(ecs::morton_key<Position>(CELL_SIZE), 2000);
+
+	sm.system("defragment").each([&](ecs::context& ctx) {
+		if (defragment)
+		{
+			defragmenter.update(ctx);
+		}
+	},
+		true);
+	sm.system<Position, Velocity>("move").each(Move, true);
+	sm.system("clear_grid").each(ClearGrid, true);
+	sm.system<Position>("fill_grid").each(FillGrid, true);
+	sm.system<Position, Collider>("collide").each(Collide, true);
+
+	MeasureFrames(looper, 10);
+	auto before = MeasureFrames(looper, FRAMES);
+
+	defragment = true;
+	size_t settleFrames = 0;
+	while (!defragmenter.settled())
+	{
+		looper.frame(1.f / 60.f);
+		++settleFrames;
+	}
+	defragment = false;
+
+	MeasureFrames(looper, 10);
+	auto after = MeasureFrames(looper, FRAMES);
+
+	std::cout << "entities:          " << ENTITY_COUNT << '\n'
+			  << "frame before (ms): " << before << '\n'
+			  << "settle frames:     " << settleFrames << '\n'
+			  << "frame after (ms):  " << after << '\n'
+			  << "speedup:           " << before / after << "x\n";
+
+	return EXIT_SUCCESS;
+}
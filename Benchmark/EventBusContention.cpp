@@ -0,0 +1,134 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "../ECS/ecs.hpp"
+
+namespace
+{
+constexpr size_t EVENTS_PER_THREAD = 200000;
+constexpr size_t SUBSCRIBERS = 4;
+
+struct Hit : ecs::event
+{
+	size_t value = 0;
+};
+
+thread_local size_t handled = 0;
+
+void Handle(const Hit& hit)
+{
+	handled += hit.value;
+}
+
+/**
+ * @brief          ,
+ * @brief       .   .
+ */
+class LockedBus
+{
+public:
+	void subscribe(std::function<void(const Hit&)> callback)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_subscribers[typeid(Hit)].push_back(std::move(callback));
+	}
+
+	void publish(const Hit& hit)
+	{
+		std::vector<std::function<void(const Hit&)>> handlers;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_subscribers.find(typeid(Hit));
+			if (it != m_subscribers.end())
+			{
+				handlers = it->second;
+			}
+		}
+		for (const auto& handler : handlers)
+		{
+			handler(hit);
+		}
+	}
+
+private:
+	std::unordered_map<std::type_index, std::vector<std::function<void(const Hit&)>>> m_subscribers;
+	std::mutex m_mutex;
+};
+
+/**
+ * @brief      .
+ * @brief   ,     .
+ */
+template <typename _TBus, typename _TChurn>
+double Measure(_TBus& bus, size_t threads, _TChurn&& churn)
+{
+	std::atomic<bool> running = true;
+	std::thread churner([&]() {
+		while (running)
+		{
+			churn(bus);
+		}
+	});
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> publishers;
+	for (size_t t = 0; t < threads; ++t)
+	{
+		publishers.emplace_back([&bus]() {
+			Hit hit;
+			hit.value = 1;
+			for (size_t i = 0; i < EVENTS_PER_THREAD; ++i)
+			{
+				bus.publish(hit);
+			}
+		});
+	}
+	for (auto& publisher : publishers)
+	{
+		publisher.join();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	running = false;
+	churner.join();
+	return threads * EVENTS_PER_THREAD / elapsed.count();
+}
+} // namespace
+
+int main()
+{
+	std::vector<size_t> threadCounts = { 1, 2, 4, 8, 16 };
+
+	std::cout << "threads  locked (events/s)  copy-on-write (events/s)\n";
+	for (auto threads : threadCounts)
+	{
+		LockedBus locked;
+		ecs::event_bus bus;
+		for (size_t i = 0; i < SUBSCRIBERS; ++i)
+		{
+			locked.subscribe(Handle);
+			bus.subscribe<Hit>(Handle);
+		}
+
+		auto lockedRate = Measure(locked, threads, [](LockedBus&) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		});
+		auto cowRate = Measure(bus, threads, [](ecs::event_bus& bus) {
+			auto subscription = bus.subscribe<Hit>(Handle);
+			bus.unsubscribe(subscription);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		});
+
+		std::cout << threads << "\t " << lockedRate << "\t\t    " << cowRate << '\n';
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -4,4 +4,16 @@
 #include "./src/flecs_alike/entity_manager.hpp"
 #include "./src/flecs_alike/event_bus.hpp"
 #include "./src/flecs_alike/context.hpp"
-#include "./src/flecs_alike/looper.hpp"
\ No newline at end of file
+#include "./src/flecs_alike/looper.hpp"
+#include "./src/flecs_alike/defragmenter.hpp"
+#include "./src/flecs_alike/frame_allocator.hpp"
+#include "./src/flecs_alike/interest.hpp"
+#include "./src/flecs_alike/observer.hpp"
+#include "./src/flecs_alike/pipeline.hpp"
+#include "./src/flecs_alike/prefab.hpp"
+#include "./src/flecs_alike/replay.hpp"
+#include "./src/flecs_alike/rollback.hpp"
+#include "./src/flecs_alike/sparse_set.hpp"
+#include "./src/flecs_alike/static_world.hpp"
+#include "./src/flecs_alike/transform.hpp"
+#include "./src/flecs_alike/world_host.hpp"
\ No newline at end of file
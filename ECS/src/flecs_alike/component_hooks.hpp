@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <typeindex>
+
+namespace ecs
+{
+class entity;
+
+/**
+ * @brief       .
+ * @brief   ,   .
+ */
+class component_hooks
+{
+public:
+	virtual ~component_hooks() = default;
+
+	/**
+	 * @brief     .
+	 */
+	virtual void on_add(entity& e, std::type_index type, const std::shared_ptr<void>& component) = 0;
+
+	/**
+	 * @brief    .
+	 * @brief        .
+	 */
+	virtual void on_remove(entity& e, std::type_index type, const std::shared_ptr<void>& component) = 0;
+
+	/**
+	 * @brief       .
+	 */
+	virtual void on_set(entity& e, std::type_index type, const std::shared_ptr<void>& component) = 0;
+};
+} // namespace ecs
@@ -1,10 +1,36 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
 #include "entity_manager.hpp"
 #include "event_bus.hpp"
+#include "frame_allocator.hpp"
 
 namespace ecs
 {
+namespace detail
+{
+inline size_t next_resource_id()
+{
+	static std::atomic<size_t> counter = 0;
+	return counter++;
+}
+
+/**
+ * @brief     .
+ * @brief        .
+ */
+template <typename T>
+size_t resource_id()
+{
+	static const size_t ID = next_resource_id();
+	return ID;
+}
+} // namespace detail
+
 /**
  * @brief  .
  * @brief    
@@ -21,12 +47,78 @@ public:
 
 	float delta_time = 0;
 	size_t entity_id = 0;
+	size_t tick = 0;
 
 	ecs::entity_manager& entity() { return m_manager; }
 	ecs::event_bus& event_bus() { return m_event_bus; }
 
+	/**
+	 * @brief     .
+	 * @brief      ,     .
+	 * @see ecs::system_manager::update()
+	 */
+	frame_allocator& frame_alloc() { return m_frameAllocator; }
+
+	/**
+	 * @brief       .
+	 * @brief       .
+	 */
+	template <typename T, typename... Args>
+	T& set_resource(Args&&... args)
+	{
+		auto ID = detail::resource_id<T>();
+		if (ID >= m_resources.size())
+		{
+			m_resources.resize(ID + 1);
+		}
+		auto resource = std::make_shared<T>(std::forward<Args>(args)...);
+		m_resources[ID] = resource;
+		return *resource;
+	}
+
+	/**
+	 * @brief     .
+	 * @brief     ,  std::out_of_range.
+	 * @see ecs::context::set_resource()
+	 */
+	template <typename T>
+	T& resource()
+	{
+		if (!has_resource<T>())
+		{
+			throw std::out_of_range("Resource is not set");
+		}
+		return *static_cast<T*>(m_resources[detail::resource_id<T>()].get());
+	}
+
+	/**
+	 * @brief ,     .
+	 */
+	template <typename T>
+	bool has_resource() const
+	{
+		auto ID = detail::resource_id<T>();
+		return ID < m_resources.size() && m_resources[ID] != nullptr;
+	}
+
+	/**
+	 * @brief    .
+	 */
+	template <typename T>
+	void remove_resource()
+	{
+		auto ID = detail::resource_id<T>();
+		if (ID < m_resources.size())
+		{
+			m_resources[ID].reset();
+		}
+	}
+
 private:
 	ecs::entity_manager& m_manager;
 	ecs::event_bus& m_event_bus;
+	frame_allocator m_frameAllocator;
+
+	std::vector<std::shared_ptr<void>> m_resources;
 };
 } // namespace ecs
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "context.hpp"
+#include "sparse_set.hpp"
+
+namespace ecs
+{
+/**
+ * @brief   Z- ()   .
+ * @brief     .
+ */
+inline std::uint64_t morton(std::int32_t x, std::int32_t y)
+{
+	auto spread = [](std::uint32_t value) {
+		std::uint64_t v = value;
+		v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+		v = (v | (v << 8)) & 0x00FF00FF00FF00FFull;
+		v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0Full;
+		v = (v | (v << 2)) & 0x3333333333333333ull;
+		v = (v | (v << 1)) & 0x5555555555555555ull;
+		return v;
+	};
+	//          
+	auto ux = static_cast<std::uint32_t>(x) ^ 0x80000000u;
+	auto uy = static_cast<std::uint32_t>(y) ^ 0x80000000u;
+	return spread(ux) | (spread(uy) << 1);
+}
+
+/**
+ * @brief    Z-   .
+ * @brief      .
+ */
+template <typename _TPosition>
+std::function<std::uint64_t(entity&)> morton_key(float cellSize)
+{
+	return [cellSize](entity& e) -> std::uint64_t {
+		auto position = e.get<_TPosition>();
+		if (!position)
+		{
+			return ~std::uint64_t(0);
+		}
+		return morton(static_cast<std::int32_t>(std::floor(position->x / cellSize)),
+			static_cast<std::int32_t>(std::floor(position->y / cellSize)));
+	};
+}
+
+/**
+ * @brief     .
+ * @brief          ,
+ * @brief         budget    
+ * @brief        ,
+ * @brief     .
+ * @brief     ,    ,
+ * @brief    .
+ * @brief  ,   :  
+ * @brief     .
+ */
+template <typename... _TComponents>
+class defragmenter
+{
+public:
+	using key_type = std::function<std::uint64_t(entity&)>;
+
+	defragmenter(key_type key, size_t budget)
+		: m_key(std::move(key))
+		, m_budget((budget > 0) ? budget : 1)
+	{
+		static_assert(((!is_sparse_v<_TComponents>)&&...), "Sparse components are already packed");
+		static_assert((std::is_copy_constructible_v<_TComponents> && ...), "Defragmented components must be copyable");
+	}
+
+	/**
+	 * @brief -   .
+	 * @see ecs::system_manager::system()
+	 */
+	void update(context& ctx)
+	{
+		auto& em = ctx.entity();
+		if (m_cursor >= m_order.size())
+		{
+			begin_cycle(em);
+		}
+
+		auto count = std::min(m_budget, m_order.size() - m_cursor);
+		m_batch.clear();
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto e = em.get(m_order[m_cursor + i]);
+			if (e && e->is_valid())
+			{
+				m_batch.push_back(e);
+			}
+		}
+		m_cursor += count;
+		(pack<_TComponents>(em), ...);
+		for (auto e : m_batch)
+		{
+			m_retired.push_back(e->compact());
+		}
+
+		if (m_cursor >= m_order.size())
+		{
+			++m_cycles;
+			m_retired.clear();
+		}
+	}
+
+	/**
+	 * @brief    .
+	 */
+	size_t cycles() const { return m_cycles; }
+
+	/**
+	 * @brief ,       .
+	 */
+	bool settled() const { return m_cycles > 0 && m_cursor >= m_order.size(); }
+
+private:
+	key_type m_key;
+	size_t m_budget;
+	size_t m_cursor = 0;
+	size_t m_cycles = 0;
+	std::vector<size_t> m_order;
+	std::vector<entity*> m_batch;
+	//       ,
+	//        
+	std::vector<std::shared_ptr<void>> m_retired;
+
+	void begin_cycle(entity_manager& em)
+	{
+		em.sort(m_key);
+
+		m_order.clear();
+		m_cursor = 0;
+		auto [begin, end] = em.all_entities();
+		for (auto it = begin; it != end; ++it)
+		{
+			if (it->is_valid())
+			{
+				m_order.push_back(it->ID());
+			}
+		}
+	}
+
+	template <typename T>
+	void pack(entity_manager& em)
+	{
+		size_t count = 0;
+		for (auto e : m_batch)
+		{
+			count += e->template has<T>() ? 1 : 0;
+		}
+		if (count == 0)
+		{
+			return;
+		}
+
+		auto block = std::make_shared<std::vector<T>>();
+		block->reserve(count);
+		for (auto e : m_batch)
+		{
+			auto component = e->template get<T>();
+			if (!component)
+				continue;
+
+			block->push_back(*component);
+			m_retired.push_back(em.relocate(*e, typeid(T), std::shared_ptr<void>(block, &block->back())));
+		}
+	}
+};
+} // namespace ecs
@@ -4,6 +4,10 @@
 #include <typeindex>
 #include <unordered_map>
 
+#include "component_hooks.hpp"
+#include "hierarchy.hpp"
+#include "sparse_set.hpp"
+
 namespace ecs
 {
 /**
@@ -12,23 +16,94 @@ namespace ecs
 class entity
 {
 public:
-	entity(size_t ID)
+	entity(size_t ID, component_hooks* hooks = nullptr, sparse_registry* sparse = nullptr)
 		: m_ID(ID)
 		, valid(true)
+		, m_hooks(hooks)
+		, m_sparse(sparse)
 	{
 	}
 
 	/**
 	 * @brief    .
 	 * @brief       .
+	 * @brief    ,   .
+	 * @see ecs::component_storage
 	 */
 	template <typename T, typename... Args>
 	entity& add(Args&&... args)
 	{
-		m_components[typeid(T)] = std::make_shared<T>(std::forward<Args>(args)...);
+		if constexpr (is_sparse_v<T>)
+		{
+			auto& set = m_sparse->set<T>();
+			bool existed = set.contains(m_ID);
+			auto& value = set.emplace(m_ID, std::forward<Args>(args)...);
+			if (m_hooks)
+			{
+				(existed)
+					? m_hooks->on_set(*this, typeid(T), unowned(&value))
+					: m_hooks->on_add(*this, typeid(T), unowned(&value));
+			}
+			return *this;
+		}
+		else
+		{
+			return add(typeid(T), std::make_shared<T>(std::forward<Args>(args)...));
+		}
+	}
+
+	/**
+	 * @brief      .
+	 * @brief    ,   .
+	 * @brief    ,   .
+	 */
+	entity& add(std::type_index componentType, std::shared_ptr<void> component)
+	{
+		auto [it, inserted] = m_components.insert_or_assign(componentType, std::move(component));
+		if (m_hooks)
+		{
+			(inserted)
+				? m_hooks->on_add(*this, it->first, it->second)
+				: m_hooks->on_set(*this, it->first, it->second);
+		}
 		return *this;
 	}
 
+	/**
+	 * @brief        .
+	 */
+	void reserve(size_t components) { m_components.reserve(components); }
+
+	/**
+	 * @brief    ,     .
+	 * @brief     ,   ,
+	 * @brief    ,    .
+	 * @brief   ,   ,    .
+	 */
+	std::shared_ptr<void> compact()
+	{
+		auto previous = std::make_shared<decltype(m_components)>(std::move(m_components));
+		m_components = decltype(m_components)(previous->begin(), previous->end(), previous->size());
+		return previous;
+	}
+
+	/**
+	 * @brief      .
+	 * @brief         .
+	 * @brief    .
+	 * @see ecs::entity_manager::relocate()
+	 */
+	std::shared_ptr<void> relocate(std::type_index componentType, std::shared_ptr<void> component)
+	{
+		auto it = m_components.find(componentType);
+		if (it == m_components.end())
+		{
+			return nullptr;
+		}
+		it->second.swap(component);
+		return component;
+	}
+
 	/**
 	 * @brief       .
 	 * @brief     ,    .
@@ -36,6 +111,10 @@ public:
 	template <typename T>
 	T* get()
 	{
+		if constexpr (is_sparse_v<T>)
+		{
+			return static_cast<T*>(m_sparse->set<T>().get(m_ID));
+		}
 		auto it = m_components.find(typeid(T));
 		return (it != m_components.end())
 			? static_cast<T*>(it->second.get())
@@ -49,17 +128,47 @@ public:
 	void* get(std::type_index componentType)
 	{
 		auto it = m_components.find(componentType);
-		return (it != m_components.end())
-			? it->second.get()
-			: nullptr;
+		if (it != m_components.end())
+		{
+			return it->second.get();
+		}
+		auto set = (m_sparse) ? m_sparse->find(componentType) : nullptr;
+		return (set) ? set->get(m_ID) : nullptr;
+	}
+
+	/**
+	 * @brief     .
+	 * @brief     ecs::parent.
+	 * @see ecs::entity_manager::hierarchy()
+	 */
+	entity& child_of(const entity& parent)
+	{
+		return add<ecs::parent>(parent.ID());
 	}
 
 	template <typename T>
 	void remove()
 	{
+		if constexpr (is_sparse_v<T>)
+		{
+			auto& set = m_sparse->set<T>();
+			if (set.contains(m_ID))
+			{
+				if (m_hooks)
+				{
+					m_hooks->on_remove(*this, typeid(T), unowned(set.get(m_ID)));
+				}
+				set.remove(m_ID);
+			}
+			return;
+		}
 		auto it = m_components.find(typeid(T));
 		if (it != m_components.end())
 		{
+			if (m_hooks)
+			{
+				m_hooks->on_remove(*this, it->first, it->second);
+			}
 			m_components.erase(it);
 		}
 	}
@@ -71,6 +180,10 @@ public:
 	template <typename T>
 	bool has() const
 	{
+		if constexpr (is_sparse_v<T>)
+		{
+			return m_sparse->set<T>().contains(m_ID);
+		}
 		return m_components.find(typeid(T)) != m_components.end();
 	}
 
@@ -80,15 +193,47 @@ public:
 	 */
 	bool has(std::type_index component) const
 	{
-		return m_components.find(component) != m_components.end();
+		if (m_components.find(component) != m_components.end())
+		{
+			return true;
+		}
+		auto set = (m_sparse) ? m_sparse->find(component) : nullptr;
+		return set && set->contains(m_ID);
 	}
 
 	/**
-	 * @brief    
+	 * @brief        
 	 * @see ecs::entity_manager::invalidate()
 	 */
 	void destruct()
 	{
+		if (!valid)
+		{
+			return;
+		}
+		if (m_hooks)
+		{
+			for (const auto& [type, component] : m_components)
+			{
+				m_hooks->on_remove(*this, type, component);
+			}
+		}
+		if (m_sparse)
+		{
+			for (const auto& [type, set] : m_sparse->sets())
+			{
+				if (!set->contains(m_ID))
+					continue;
+
+				if (m_hooks)
+				{
+					m_hooks->on_remove(*this, type, unowned(set->get(m_ID)));
+				}
+				set->remove(m_ID);
+			}
+		}
+		//           
+		m_components.clear();
 		valid = false;
 	}
 
@@ -106,7 +251,17 @@ public:
 private:
 	size_t m_ID;
 	bool valid;
+	component_hooks* m_hooks;
+	sparse_registry* m_sparse;
 
 	std::unordered_map<std::type_index, std::shared_ptr<void>> m_components;
+
+	/**
+	 * @brief        .
+	 */
+	static std::shared_ptr<void> unowned(void* component)
+	{
+		return std::shared_ptr<void>(std::shared_ptr<void>(), component);
+	}
 };
 }; // namespace ecs
@@ -1,20 +1,29 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <optional>
 #include <vector>
 
+#include "component_hooks.hpp"
 #include "entity.hpp"
+#include "hierarchy.hpp"
 #include "iterator.hpp"
+#include "prefab.hpp"
+#include "sparse_set.hpp"
 
 namespace ecs
 {
 /**
  * @brief      .
  */
-class entity_manager
+class entity_manager : private component_hooks
 {
 public:
+	entity_manager() = default;
+	entity_manager(const entity_manager&) = delete;
+	entity_manager& operator=(const entity_manager&) = delete;
+
 	/**
 	 * @brief     .
 	 * @brief       .
@@ -53,6 +62,70 @@ public:
 		return entity;
 	}
 
+	/**
+	 * @brief        .
+	 * @see ecs::entity_manager::at_scope()
+	 */
+	entity& instantiate(const prefab& prefab)
+	{
+		auto [begin, _] = instantiate(prefab, 1);
+		return *begin;
+	}
+
+	/**
+	 * @brief        .
+	 * @brief          ,
+	 * @brief  ,       .
+	 * @brief    -    ,
+	 * @brief            .
+	 * @brief      .
+	 * @see ecs::entity_manager::at_scope()
+	 */
+	std::pair<iterator<entity>, iterator<entity>> instantiate(const prefab& prefab, size_t count)
+	{
+		auto& scope = (m_currentScope)
+			? m_scopes[*m_currentScope]
+			: m_scopes[m_defaultScope];
+		m_currentScope.reset();
+
+		size_t first = scope.size();
+		scope.reserve(first + count);
+		m_entities.reserve(m_entities.size() + count);
+		size_t stored = 0;
+		for (const auto& component : prefab.components())
+		{
+			stored += component.add_to ? 0 : 1;
+		}
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto& e = create_internal();
+			e.reserve(stored);
+			scope.push_back(&e);
+		}
+
+		for (const auto& component : prefab.components())
+		{
+			if (component.add_to)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					component.add_to(*scope[first + i]);
+				}
+				continue;
+			}
+
+			auto batch = component.make_batch(count);
+			auto data = static_cast<char*>(batch.get());
+			for (size_t i = 0; i < count; ++i)
+			{
+				scope[first + i]->add(component.type, std::shared_ptr<void>(batch, data + i * component.size));
+			}
+		}
+
+		update_all();
+		return { iterator(scope, first), iterator(scope, scope.size()) };
+	}
+
 	/**
 	 * @brief      .
 	 */
@@ -62,7 +135,12 @@ public:
 		{
 			entities.erase(
 				std::remove_if(entities.begin(), entities.end(),
-					[](entity* e) { return !e->is_valid(); }),
+					[this](entity* e) {
+						if (e->is_valid())
+							return false;
+						m_hierarchy.erase(e->ID());
+						return true;
+					}),
 				entities.end());
 		}
 		update_all();
@@ -78,6 +156,106 @@ public:
 		return { iterator(m_allEntities), iterator(m_allEntities, m_allEntities.size()) };
 	}
 
+	/**
+	 * @brief       .
+	 * @brief       .
+	 */
+	template <typename _TKey>
+	void sort(_TKey&& key)
+	{
+		std::vector<std::pair<std::uint64_t, entity*>> keyed;
+		for (auto& [_, entities] : m_scopes)
+		{
+			keyed.clear();
+			keyed.reserve(entities.size());
+			for (auto e : entities)
+			{
+				keyed.emplace_back(key(*e), e);
+			}
+			std::stable_sort(keyed.begin(), keyed.end(),
+				[](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+			for (size_t i = 0; i < keyed.size(); ++i)
+			{
+				entities[i] = keyed[i].second;
+			}
+		}
+		update_all();
+	}
+
+	/**
+	 * @brief       .
+	 * @brief   ,      .
+	 * @brief    .
+	 * @see ecs::entity_manager::component_version()
+	 */
+	std::shared_ptr<void> relocate(entity& e, std::type_index componentType, std::shared_ptr<void> component)
+	{
+		++m_componentVersions[componentType];
+		return e.relocate(componentType, std::move(component));
+	}
+
+	/**
+	 * @brief     .
+	 * @brief    ,    .
+	 */
+	entity* get(size_t ID)
+	{
+		return (ID < m_entities.size())
+			? m_entities[ID].get()
+			: nullptr;
+	}
+
+	/**
+	 * @brief      .
+	 * @brief    ,    .
+	 * @see ecs::component_storage
+	 */
+	template <typename T>
+	sparse_set<T>& sparse()
+	{
+		return m_sparse.set<T>();
+	}
+
+	/**
+	 * @brief       .
+	 * @brief       ,    .
+	 */
+	sparse_set_base* sparse(std::type_index componentType)
+	{
+		return m_sparse.find(componentType);
+	}
+
+	/**
+	 * @brief   -  .
+	 * @see ecs::entity::child_of()
+	 */
+	ecs::hierarchy& hierarchy() { return m_hierarchy; }
+
+	/**
+	 * @brief     .
+	 * @brief    , ,      ,
+	 * @brief      .
+	 */
+	size_t component_version(std::type_index componentType) const
+	{
+		auto it = m_componentVersions.find(componentType);
+		return (it != m_componentVersions.end()) ? it->second : 0;
+	}
+
+	template <typename T>
+	size_t component_version() const
+	{
+		return component_version(typeid(T));
+	}
+
+	/**
+	 * @brief      .
+	 */
+	void hooks(component_hooks* hooks)
+	{
+		m_hooks = hooks;
+	}
+
 	/**
 	 * @brief         .
 	 * @brief       .
@@ -89,6 +267,12 @@ public:
 		m_scopes[m_defaultScope] = {};
 		m_allEntities.clear();
 		m_currentScope.reset();
+		m_hierarchy.clear();
+		m_sparse.clear();
+		for (auto& [_, version] : m_componentVersions)
+		{
+			++version;
+		}
 		m_nextID = 0;
 	}
 
@@ -98,6 +282,10 @@ private:
 	};
 
 	size_t m_nextID = 0;
+	std::unordered_map<std::type_index, size_t> m_componentVersions;
+	component_hooks* m_hooks = nullptr;
+	ecs::hierarchy m_hierarchy;
+	sparse_registry m_sparse;
 
 	const std::type_index m_defaultScope = typeid(initial);
 	std::optional<std::type_index> m_currentScope;
@@ -107,7 +295,7 @@ private:
 
 	entity& create_internal()
 	{
-		m_entities.emplace_back(std::make_unique<entity>(m_nextID++));
+		m_entities.emplace_back(std::make_unique<entity>(m_nextID++, static_cast<component_hooks*>(this), &m_sparse));
 		return *m_entities.back();
 	}
 
@@ -119,5 +307,44 @@ private:
 			m_allEntities.insert(m_allEntities.end(), entities.begin(), entities.end());
 		}
 	}
+
+	void on_add(entity& e, std::type_index type, const std::shared_ptr<void>& component) override
+	{
+		++m_componentVersions[type];
+		if (type == typeid(parent))
+		{
+			m_hierarchy.attach(e.ID(), static_cast<parent*>(component.get())->ID);
+		}
+		if (m_hooks)
+		{
+			m_hooks->on_add(e, type, component);
+		}
+	}
+
+	void on_remove(entity& e, std::type_index type, const std::shared_ptr<void>& component) override
+	{
+		++m_componentVersions[type];
+		if (type == typeid(parent))
+		{
+			m_hierarchy.detach(e.ID());
+		}
+		if (m_hooks)
+		{
+			m_hooks->on_remove(e, type, component);
+		}
+	}
+
+	void on_set(entity& e, std::type_index type, const std::shared_ptr<void>& component) override
+	{
+		++m_componentVersions[type];
+		if (type == typeid(parent))
+		{
+			m_hierarchy.attach(e.ID(), static_cast<parent*>(component.get())->ID);
+		}
+		if (m_hooks)
+		{
+			m_hooks->on_set(e, type, component);
+		}
+	}
 };
 } // namespace ecs
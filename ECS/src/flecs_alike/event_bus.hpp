@@ -1,15 +1,45 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <thread>
-#include <typeindex>
-#include <unordered_map>
 #include <vector>
 
 namespace ecs
 {
+namespace detail
+{
+inline size_t next_event_id()
+{
+	static std::atomic<size_t> counter = 0;
+	return counter++;
+}
+
+/**
+ * @brief     .
+ * @brief        .
+ */
+template <typename T>
+size_t event_id()
+{
+	static const size_t ID = next_event_id();
+	return ID;
+}
+
+/**
+ * @brief     .
+ * @brief         .
+ */
+inline size_t thread_number()
+{
+	static std::atomic<size_t> counter = 0;
+	thread_local const size_t number = counter++;
+	return number;
+}
+} // namespace detail
+
 /**
  * @brief  .
  * @brief   
@@ -22,70 +52,170 @@ struct event
 
 /**
  * @brief   
+ * @brief   :      
+ * @brief    ,   
+ * @brief       .
+ * @brief       .
+ * @brief   ,     :
+ * @brief   ,    collect().
  */
 class event_bus
 {
-	using event_id = std::type_index;
 	using handler = std::function<void(const event&)>;
-	using subscribers = std::unordered_map<event_id, std::vector<handler>>;
 
-	subscribers m_subscribers;
+	struct subscriber
+	{
+		size_t ID;
+		handler callback;
+	};
+
+	using table = std::vector<std::vector<subscriber>>;
+
+	//     -,      
+	struct alignas(64) reader_count
+	{
+		std::atomic<size_t> value = 0;
+	};
+
+	static constexpr size_t READER_COUNTS = 64;
+
+	std::atomic<const table*> m_table;
+	std::array<reader_count, READER_COUNTS> m_readers;
+	std::vector<std::unique_ptr<const table>> m_retired;
+	size_t m_nextID = 0;
 	std::mutex m_mutex;
 
 public:
+	event_bus()
+		: m_table(new table())
+	{
+	}
+
+	~event_bus()
+	{
+		delete m_table.load();
+	}
+
+	event_bus(const event_bus&) = delete;
+	event_bus& operator=(const event_bus&) = delete;
+
 	/**
 	 * @brief  -  .
 	 * @brief -      .
+	 * @brief     .
 	 * @see ecs::event_bus::publish()
+	 * @see ecs::event_bus::unsubscribe()
 	 */
 	template <typename _TEvent>
-	void subscribe(std::function<void(const _TEvent&)> callback)
+	size_t subscribe(std::function<void(const _TEvent&)> callback)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
 
-		auto ID = id_of<_TEvent>();
-		m_subscribers[ID].push_back(
-			[callback](const event& e) { callback(static_cast<const _TEvent&>(e)); });
+		auto ID = detail::event_id<_TEvent>();
+		auto next = std::make_unique<table>(*m_table.load(std::memory_order_relaxed));
+		if (ID >= next->size())
+		{
+			next->resize(ID + 1);
+		}
+		(*next)[ID].push_back({ m_nextID,
+			[callback = std::move(callback)](const event& e) { callback(static_cast<const _TEvent&>(e)); } });
+		replace(std::move(next));
+		return m_nextID++;
 	}
 
 	/**
-	 * @brief      .
-	 * @see ecs::event_bus::publish()
+	 * @brief  -   .
+	 * @brief        .
+	 * @see ecs::event_bus::subscribe()
+	 */
+	void unsubscribe(size_t subscription)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto next = std::make_unique<table>(*m_table.load(std::memory_order_relaxed));
+		for (auto& subscribers : *next)
+		{
+			std::erase_if(subscribers, [subscription](const subscriber& s) { return s.ID == subscription; });
+		}
+		replace(std::move(next));
+	}
+
+	/**
+	 * @brief      
+	 * @brief   ,   .
+	 * @brief      .
+	 * @see ecs::event_bus::subscribe()
 	 */
 	template <typename _TEvent>
 	void publish(const _TEvent& event)
 	{
-		std::vector<handler> handlers;
+		reader_guard guard(m_readers[detail::thread_number() % READER_COUNTS].value);
+		const auto& subscribers = *m_table.load();
+		auto ID = detail::event_id<_TEvent>();
+		if (ID >= subscribers.size())
 		{
-			std::lock_guard<std::mutex> lock(m_mutex);
-			auto ID = id_of(event);
-			auto it = m_subscribers.find(ID);
-			if (it != m_subscribers.end())
-			{
-				handlers = it->second;
-			}
+			return;
 		}
-
-		std::vector<std::thread> threads;
-		for (const auto& handler : handlers)
+		for (const auto& subscriber : subscribers[ID])
 		{
-			threads.emplace_back([handler, &event]() { handler(event); });
+			subscriber.callback(event);
 		}
+	}
+
+	/**
+	 * @brief    ,       .
+	 * @brief      .
+	 * @see ecs::system_manager::update()
+	 */
+	void collect()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		collect_retired();
+	}
 
-		for (auto& thread : threads)
+private:
+	/**
+	 * @brief          .
+	 */
+	class reader_guard
+	{
+	public:
+		explicit reader_guard(std::atomic<size_t>& count)
+			: m_count(count)
 		{
-			if (thread.joinable())
-			{
-				thread.join();
-			}
+			m_count.fetch_add(1);
 		}
+
+		~reader_guard() { m_count.fetch_sub(1, std::memory_order_release); }
+
+		reader_guard(const reader_guard&) = delete;
+		reader_guard& operator=(const reader_guard&) = delete;
+
+	private:
+		std::atomic<size_t>& m_count;
+	};
+
+	void replace(std::unique_ptr<const table> next)
+	{
+		m_retired.emplace_back(m_table.exchange(next.release()));
+		collect_retired();
 	}
 
-private:
-	template <typename _TEvent>
-	std::type_index id_of(const _TEvent&)
+	void collect_retired()
 	{
-		return std::type_index(typeid(_TEvent));
+		if (m_retired.empty())
+		{
+			return;
+		}
+		// ,   ,      
+		for (const auto& readers : m_readers)
+		{
+			if (readers.value.load() != 0)
+			{
+				return;
+			}
+		}
+		m_retired.clear();
 	}
 };
 } // namespace ecs
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace ecs
+{
+/**
+ * @brief      .
+ * @brief   -     ,
+ * @brief      .
+ * @brief      reset()   .
+ * @brief   std::pmr: std::pmr::vector<int> v(&ctx.frame_alloc());
+ * @see ecs::context::frame_alloc()
+ */
+class frame_allocator : public std::pmr::memory_resource
+{
+public:
+	explicit frame_allocator(size_t capacity = 64 * 1024)
+	{
+		add_block(capacity);
+	}
+
+	/**
+	 * @brief      .
+	 * @brief      ,    ,
+	 * @brief         .
+	 */
+	void reset()
+	{
+		if (m_blocks.size() > 1)
+		{
+			auto capacity = this->capacity();
+			m_blocks.clear();
+			add_block(capacity);
+		}
+		m_offset = 0;
+		m_used = 0;
+	}
+
+	/**
+	 * @brief  ,    reset().
+	 */
+	size_t used() const { return m_used; }
+
+	/**
+	 * @brief      .
+	 */
+	size_t capacity() const
+	{
+		size_t capacity = 0;
+		for (const auto& block : m_blocks)
+		{
+			capacity += block.size;
+		}
+		return capacity;
+	}
+
+private:
+	struct block
+	{
+		std::unique_ptr<std::byte[]> data;
+		size_t size;
+	};
+
+	std::vector<block> m_blocks;
+	size_t m_offset = 0;
+	size_t m_used = 0;
+
+	void add_block(size_t size)
+	{
+		m_blocks.push_back({ std::make_unique<std::byte[]>(size), size });
+		m_offset = 0;
+	}
+
+	void* do_allocate(size_t bytes, size_t alignment) override
+	{
+		auto& current = m_blocks.back();
+		auto address = reinterpret_cast<std::uintptr_t>(current.data.get()) + m_offset;
+		auto padding = (alignment - address % alignment) % alignment;
+		if (m_offset + padding + bytes > current.size)
+		{
+			add_block(std::max(current.size * 2, bytes + alignment));
+			return do_allocate(bytes, alignment);
+		}
+
+		m_offset += padding + bytes;
+		m_used += bytes;
+		return reinterpret_cast<void*>(address + padding);
+	}
+
+	void do_deallocate(void*, size_t, size_t) override
+	{
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+} // namespace ecs
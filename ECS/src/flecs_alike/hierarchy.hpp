@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace ecs
+{
+/**
+ * @brief     .
+ * @see ecs::entity::child_of()
+ */
+struct parent
+{
+	size_t ID;
+};
+
+/**
+ * @brief       .
+ */
+struct hierarchy_node
+{
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+	size_t entity;
+	size_t parent;
+	size_t parent_index;
+};
+
+/**
+ * @brief     -.
+ * @brief        ecs::parent,
+ * @brief          .
+ */
+class hierarchy
+{
+public:
+	/**
+	 * @brief     .
+	 * @brief    .
+	 */
+	void attach(size_t child, size_t parent)
+	{
+		detach(child);
+		m_parents[child] = parent;
+		m_children[parent].push_back(child);
+		m_dirty = true;
+	}
+
+	/**
+	 * @brief      .
+	 */
+	void detach(size_t child)
+	{
+		auto it = m_parents.find(child);
+		if (it == m_parents.end())
+		{
+			return;
+		}
+		auto& siblings = m_children[it->second];
+		siblings.erase(std::remove(siblings.begin(), siblings.end(), child), siblings.end());
+		if (siblings.empty())
+		{
+			m_children.erase(it->second);
+		}
+		m_parents.erase(it);
+		m_dirty = true;
+	}
+
+	/**
+	 * @brief          .
+	 */
+	void erase(size_t entity)
+	{
+		detach(entity);
+		auto it = m_children.find(entity);
+		if (it == m_children.end())
+		{
+			return;
+		}
+		for (auto child : it->second)
+		{
+			m_parents.erase(child);
+		}
+		m_children.erase(it);
+		m_dirty = true;
+	}
+
+	/**
+	 * @brief   .
+	 */
+	const std::vector<size_t>& children(size_t parent) const
+	{
+		static const std::vector<size_t> empty;
+		auto it = m_children.find(parent);
+		return (it != m_children.end()) ? it->second : empty;
+	}
+
+	/**
+	 * @brief        .
+	 * @brief        .
+	 */
+	const std::vector<hierarchy_node>& nodes()
+	{
+		if (m_dirty)
+		{
+			rebuild();
+		}
+		return m_nodes;
+	}
+
+	/**
+	 * @brief    .
+	 * @brief    .
+	 */
+	size_t version() const { return m_version; }
+
+	void clear()
+	{
+		m_parents.clear();
+		m_children.clear();
+		m_nodes.clear();
+		m_dirty = false;
+		++m_version;
+	}
+
+private:
+	std::unordered_map<size_t, size_t> m_parents;
+	std::unordered_map<size_t, std::vector<size_t>> m_children;
+	std::vector<hierarchy_node> m_nodes;
+	bool m_dirty = false;
+	size_t m_version = 0;
+
+	void rebuild()
+	{
+		std::vector<size_t> roots;
+		for (const auto& [parent, _] : m_children)
+		{
+			if (m_parents.find(parent) == m_parents.end())
+			{
+				roots.push_back(parent);
+			}
+		}
+		std::sort(roots.begin(), roots.end());
+
+		m_nodes.clear();
+		for (auto root : roots)
+		{
+			size_t begin = m_nodes.size();
+			for (auto child : m_children[root])
+			{
+				m_nodes.push_back({ child, root, hierarchy_node::npos });
+			}
+			for (size_t i = begin; i < m_nodes.size(); ++i)
+			{
+				auto it = m_children.find(m_nodes[i].entity);
+				if (it == m_children.end())
+					continue;
+
+				for (auto child : it->second)
+				{
+					m_nodes.push_back({ child, m_nodes[i].entity, i });
+				}
+			}
+		}
+		m_dirty = false;
+		++m_version;
+	}
+};
+} // namespace ecs
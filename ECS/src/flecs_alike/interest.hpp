@@ -0,0 +1,324 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "system_manager.hpp"
+
+namespace ecs
+{
+/**
+ * @brief     .
+ * @brief      ,
+ * @brief          .
+ * @brief        
+ * @brief     ,    
+ * @brief   ,     .
+ */
+class interest_manager
+{
+public:
+	using listener = std::function<void(size_t client, size_t entity)>;
+
+	explicit interest_manager(float cellSize)
+		: m_cellSize(cellSize)
+	{
+	}
+
+	/**
+	 * @brief       .
+	 * @brief      x  y.
+	 */
+	template <typename _TPosition>
+	void attach(system_manager& manager)
+	{
+		manager.system<_TPosition>("InterestManagement")
+			.each([this](context& ctx, _TPosition& position) { move(ctx.entity_id, position.x, position.y); }, true);
+		manager.observer<_TPosition>("InterestManagementRemove")
+			.on_remove()
+			.each([this](context& ctx, _TPosition&) { erase(ctx.entity_id); }, true);
+	}
+
+	/**
+	 * @brief  ,       .
+	 */
+	void on_enter(listener listener) { m_onEnter = std::move(listener); }
+
+	/**
+	 * @brief  ,       .
+	 */
+	void on_leave(listener listener) { m_onLeave = std::move(listener); }
+
+	/**
+	 * @brief  ,       .
+	 * @brief     .
+	 */
+	void add_client(size_t entity, int radius)
+	{
+		remove_client(entity);
+		auto& client = m_clients[entity];
+		client.radius = radius;
+		auto it = m_entities.find(entity);
+		if (it != m_entities.end())
+		{
+			view(entity, client, it->second);
+		}
+	}
+
+	/**
+	 * @brief  .       on_leave.
+	 */
+	void remove_client(size_t entity)
+	{
+		auto it = m_clients.find(entity);
+		if (it == m_clients.end())
+		{
+			return;
+		}
+		auto& client = it->second;
+		if (client.placed)
+		{
+			for_range(client.center, client.radius, [&](key cell) { unwatch(entity, client, cell); });
+		}
+		m_clients.erase(it);
+	}
+
+	/**
+	 * @brief   .
+	 */
+	void move(size_t entity, float x, float y)
+	{
+		key cell = cell_of(x, y);
+		auto [it, inserted] = m_entities.try_emplace(entity, cell);
+		if (!inserted && it->second == cell)
+		{
+			return;
+		}
+
+		std::optional<key> previous;
+		if (!inserted)
+		{
+			previous = it->second;
+			remove_from_cell(entity, *previous);
+			it->second = cell;
+		}
+		m_cells[cell].push_back(entity);
+
+		if (previous)
+		{
+			for_watchers(*previous, [&](size_t ID, client_state& client) {
+				if (!client.covers(cell))
+					leave(ID, client, entity);
+			});
+		}
+		for_watchers(cell, [&](size_t ID, client_state& client) {
+			enter(ID, client, entity);
+		});
+
+		auto client = m_clients.find(entity);
+		if (client != m_clients.end())
+		{
+			view(entity, client->second, cell);
+		}
+	}
+
+	/**
+	 * @brief         .
+	 */
+	void erase(size_t entity)
+	{
+		remove_client(entity);
+		auto it = m_entities.find(entity);
+		if (it == m_entities.end())
+		{
+			return;
+		}
+		auto cell = it->second;
+		remove_from_cell(entity, cell);
+		m_entities.erase(it);
+		for_watchers(cell, [&](size_t ID, client_state& client) { leave(ID, client, entity); });
+	}
+
+	/**
+	 * @brief  ,  .
+	 */
+	const std::unordered_set<size_t>& relevant(size_t client) const
+	{
+		static const std::unordered_set<size_t> empty;
+		auto it = m_clients.find(client);
+		return (it != m_clients.end()) ? it->second.relevant : empty;
+	}
+
+private:
+	using key = std::uint64_t;
+
+	struct client_state
+	{
+		int radius = 0;
+		bool placed = false;
+		key center = 0;
+		std::unordered_set<size_t> relevant;
+
+		bool covers(key cell) const
+		{
+			return placed
+				&& std::abs(cell_x(cell) - cell_x(center)) <= radius
+				&& std::abs(cell_y(cell) - cell_y(center)) <= radius;
+		}
+	};
+
+	float m_cellSize;
+	std::unordered_map<size_t, key> m_entities;
+	std::unordered_map<key, std::vector<size_t>> m_cells;
+	std::unordered_map<key, std::vector<size_t>> m_watchers;
+	std::unordered_map<size_t, client_state> m_clients;
+	listener m_onEnter;
+	listener m_onLeave;
+
+	static key make_key(std::int32_t x, std::int32_t y)
+	{
+		return (static_cast<key>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+	}
+
+	static std::int32_t cell_x(key cell) { return static_cast<std::int32_t>(cell >> 32); }
+	static std::int32_t cell_y(key cell) { return static_cast<std::int32_t>(cell & 0xFFFFFFFFu); }
+
+	key cell_of(float x, float y) const
+	{
+		return make_key(static_cast<std::int32_t>(std::floor(x / m_cellSize)),
+			static_cast<std::int32_t>(std::floor(y / m_cellSize)));
+	}
+
+	template <typename _TFn>
+	static void for_range(key center, int radius, _TFn&& __fn)
+	{
+		for (int dx = -radius; dx <= radius; ++dx)
+		{
+			for (int dy = -radius; dy <= radius; ++dy)
+			{
+				__fn(make_key(cell_x(center) + dx, cell_y(center) + dy));
+			}
+		}
+	}
+
+	template <typename _TFn>
+	void for_watchers(key cell, _TFn&& __fn)
+	{
+		auto it = m_watchers.find(cell);
+		if (it == m_watchers.end())
+		{
+			return;
+		}
+		for (auto ID : it->second)
+		{
+			__fn(ID, m_clients[ID]);
+		}
+	}
+
+	void remove_from_cell(size_t entity, key cell)
+	{
+		auto it = m_cells.find(cell);
+		if (it == m_cells.end())
+		{
+			return;
+		}
+		auto& entities = it->second;
+		auto found = std::find(entities.begin(), entities.end(), entity);
+		if (found != entities.end())
+		{
+			*found = entities.back();
+			entities.pop_back();
+		}
+		if (entities.empty())
+		{
+			m_cells.erase(it);
+		}
+	}
+
+	/**
+	 * @brief      ,
+	 * @brief   ,      .
+	 */
+	void view(size_t ID, client_state& client, key center)
+	{
+		client_state previous;
+		previous.radius = client.radius;
+		previous.center = client.center;
+		previous.placed = client.placed;
+
+		client.center = center;
+		client.placed = true;
+		if (previous.placed)
+		{
+			for_range(previous.center, previous.radius, [&](key cell) {
+				if (!client.covers(cell))
+					unwatch(ID, client, cell);
+			});
+		}
+		for_range(center, client.radius, [&](key cell) {
+			if (!previous.covers(cell))
+				watch(ID, client, cell);
+		});
+	}
+
+	void watch(size_t ID, client_state& client, key cell)
+	{
+		m_watchers[cell].push_back(ID);
+		auto it = m_cells.find(cell);
+		if (it == m_cells.end())
+		{
+			return;
+		}
+		for (auto entity : it->second)
+		{
+			enter(ID, client, entity);
+		}
+	}
+
+	void unwatch(size_t ID, client_state& client, key cell)
+	{
+		auto watchers = m_watchers.find(cell);
+		if (watchers != m_watchers.end())
+		{
+			auto& list = watchers->second;
+			list.erase(std::remove(list.begin(), list.end(), ID), list.end());
+			if (list.empty())
+			{
+				m_watchers.erase(watchers);
+			}
+		}
+		auto it = m_cells.find(cell);
+		if (it == m_cells.end())
+		{
+			return;
+		}
+		for (auto entity : it->second)
+		{
+			leave(ID, client, entity);
+		}
+	}
+
+	void enter(size_t ID, client_state& client, size_t entity)
+	{
+		if (client.relevant.insert(entity).second && m_onEnter)
+		{
+			m_onEnter(ID, entity);
+		}
+	}
+
+	void leave(size_t ID, client_state& client, size_t entity)
+	{
+		if (client.relevant.erase(entity) > 0 && m_onLeave)
+		{
+			m_onLeave(ID, entity);
+		}
+	}
+};
+} // namespace ecs
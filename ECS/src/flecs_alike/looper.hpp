@@ -17,7 +17,18 @@ class looper
 	using clock = std::chrono::high_resolution_clock;
 	using duration = std::chrono::duration<float>;
 
+	using frame_listener = std::function<void(float)>;
+
+	struct listener_entry
+	{
+		size_t ID;
+		frame_listener callback;
+	};
+
 	system_manager& m_manager;
+	std::vector<listener_entry> m_beginListeners;
+	std::vector<listener_entry> m_endListeners;
+	size_t m_nextListenerID = 0;
 
 public:
 	looper(system_manager& manager)
@@ -25,9 +36,51 @@ public:
 	{
 	}
 
+	system_manager& manager() { return m_manager; }
+
+	/**
+	 * @brief  ,       .
+	 * @brief     .
+	 * @see ecs::looper::remove_listener()
+	 */
+	size_t on_frame_begin(frame_listener listener)
+	{
+		m_beginListeners.push_back({ m_nextListenerID, std::move(listener) });
+		return m_nextListenerID++;
+	}
+
+	/**
+	 * @brief  ,       .
+	 * @brief     .
+	 * @see ecs::looper::remove_listener()
+	 */
+	size_t on_frame_end(frame_listener listener)
+	{
+		m_endListeners.push_back({ m_nextListenerID, std::move(listener) });
+		return m_nextListenerID++;
+	}
+
+	/**
+	 * @brief  ,   on_frame_begin()  on_frame_end().
+	 */
+	void remove_listener(size_t ID)
+	{
+		auto matches = [ID](const listener_entry& entry) { return entry.ID == ID; };
+		std::erase_if(m_beginListeners, matches);
+		std::erase_if(m_endListeners, matches);
+	}
+
 	void frame(float delta_time)
 	{
+		for (const auto& listener : m_beginListeners)
+		{
+			listener.callback(delta_time);
+		}
 		m_manager.update(delta_time);
+		for (const auto& listener : m_endListeners)
+		{
+			listener.callback(delta_time);
+		}
 	}
 
 	void loop(std::optional<unsigned int> targetFPS = std::nullopt)
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <typeindex>
+
+#include "context.hpp"
+
+namespace ecs
+{
+/**
+ * @brief    .
+ */
+enum class observer_event : unsigned
+{
+	on_add = 1 << 0,
+	on_remove = 1 << 1,
+	on_set = 1 << 2,
+};
+
+/**
+ * @brief    
+ */
+class observer_impl
+{
+public:
+	using callback_type = std::function<void(context&, void*)>;
+	using retain_type = std::function<std::shared_ptr<void>(void*)>;
+
+	observer_impl(std::string name, std::type_index component)
+		: m_name(std::move(name))
+		, m_component(component)
+	{
+	}
+
+	std::type_index component() const { return m_component; }
+
+	void add_event(observer_event event) { m_events |= static_cast<unsigned>(event); }
+	bool listens(observer_event event) const { return m_events & static_cast<unsigned>(event); }
+
+	void deferred(bool value) { m_deferred = value; }
+	bool deferred() const { return m_deferred; }
+
+	void callback(callback_type __fn) { m_callback = std::move(__fn); }
+	const callback_type& callback() const { return m_callback; }
+
+	/**
+	 * @brief  ,    .
+	 */
+	void retain(retain_type __fn) { m_retain = std::move(__fn); }
+	std::shared_ptr<void> retain(void* component) const { return m_retain(component); }
+
+private:
+	std::string m_name;
+	std::type_index m_component;
+	unsigned m_events = 0;
+	bool m_deferred = false;
+	callback_type m_callback;
+	retain_type m_retain;
+};
+} // namespace ecs
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "looper.hpp"
+
+namespace ecs
+{
+/**
+ * @brief     .
+ * @brief  N+1    ,   
+ * @brief    N.
+ * @brief     :     ,
+ * @brief   ,     .
+ * @brief        .
+ */
+template <typename _TSnapshot>
+class frame_pipeline
+{
+public:
+	explicit frame_pipeline(ecs::looper& looper)
+		: m_looper(looper)
+	{
+		m_worker = std::thread([this]() { run(); });
+	}
+
+	frame_pipeline(const frame_pipeline&) = delete;
+	frame_pipeline& operator=(const frame_pipeline&) = delete;
+
+	~frame_pipeline()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			m_stopping = true;
+		}
+		m_condition.notify_all();
+		m_worker.join();
+	}
+
+	/**
+	 * @brief    .
+	 * @brief      .
+	 */
+	_TSnapshot& back() { return m_buffers[1 - m_front]; }
+
+	/**
+	 * @brief    -    .
+	 */
+	const _TSnapshot& front() const { return m_buffers[m_front]; }
+
+	/**
+	 * @brief       ,
+	 * @brief  render      ,
+	 * @brief       .
+	 * @brief        .
+	 */
+	template <typename _TRender>
+	void frame(float delta_time, _TRender&& render)
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			m_deltaTime = delta_time;
+			m_pending = true;
+		}
+		m_condition.notify_all();
+
+		try
+		{
+			render(std::as_const(m_buffers[m_front]));
+		}
+		catch (...)
+		{
+			//       
+			wait();
+			throw;
+		}
+		wait();
+		m_front = 1 - m_front;
+
+		if (auto error = std::exchange(m_error, nullptr))
+		{
+			std::rethrow_exception(error);
+		}
+	}
+
+private:
+	ecs::looper& m_looper;
+	_TSnapshot m_buffers[2];
+	size_t m_front = 0;
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	float m_deltaTime = 0;
+	bool m_pending = false;
+	bool m_stopping = false;
+	std::exception_ptr m_error;
+	std::thread m_worker;
+
+	void wait()
+	{
+		std::unique_lock lock(m_mutex);
+		m_condition.wait(lock, [this]() { return !m_pending; });
+	}
+
+	void run()
+	{
+		std::unique_lock lock(m_mutex);
+		while (true)
+		{
+			m_condition.wait(lock, [this]() { return m_pending || m_stopping; });
+			if (m_stopping)
+			{
+				return;
+			}
+
+			auto delta_time = m_deltaTime;
+			lock.unlock();
+			try
+			{
+				m_looper.frame(delta_time);
+			}
+			catch (...)
+			{
+				m_error = std::current_exception();
+			}
+			lock.lock();
+			m_pending = false;
+			m_condition.notify_all();
+		}
+	}
+};
+} // namespace ecs
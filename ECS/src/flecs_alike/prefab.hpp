@@ -0,0 +1,77 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+#include "entity.hpp"
+
+namespace ecs
+{
+/**
+ * @brief   .
+ * @brief       ,
+ * @brief    .
+ * @see ecs::entity_manager::instantiate()
+ */
+class prefab
+{
+public:
+	/**
+	 * @brief  .
+	 * @brief         .
+	 * @brief        .
+	 */
+	struct component
+	{
+		std::type_index type;
+		size_t size;
+		std::function<std::shared_ptr<void>(size_t count)> make_batch;
+		std::function<void(entity&)> add_to;
+	};
+
+	/**
+	 * @brief    .
+	 * @brief       ,
+	 * @brief       .
+	 */
+	template <typename T, typename... Args>
+	prefab& add(Args&&... args)
+	{
+		auto prototype = std::make_shared<const T>(std::forward<Args>(args)...);
+		auto makeBatch = [prototype](size_t count) -> std::shared_ptr<void> {
+			auto batch = std::make_shared<std::vector<T>>(count, *prototype);
+			return std::shared_ptr<void>(batch, batch->data());
+		};
+		auto addTo = [prototype](entity& e) {
+			e.add<T>(*prototype);
+		};
+		component templ{ typeid(T), sizeof(T), nullptr, nullptr };
+		if constexpr (is_sparse_v<T>)
+		{
+			templ.add_to = std::move(addTo);
+		}
+		else
+		{
+			templ.make_batch = std::move(makeBatch);
+		}
+
+		for (auto& existing : m_components)
+		{
+			if (existing.type == templ.type)
+			{
+				existing = std::move(templ);
+				return *this;
+			}
+		}
+		m_components.push_back(std::move(templ));
+		return *this;
+	}
+
+	const std::vector<component>& components() const { return m_components; }
+
+private:
+	std::vector<component> m_components;
+};
+} // namespace ecs
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "event_bus.hpp"
+#include "looper.hpp"
+
+namespace ecs
+{
+namespace detail
+{
+constexpr char replay_magic[4] = { 'S', 'S', 'L', 'R' };
+constexpr std::uint32_t replay_version = 1;
+
+enum class replay_record : std::uint8_t
+{
+	frame = 0,
+	event = 1,
+};
+
+template <typename T>
+void write_raw(std::vector<char>& out, const T& value)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "Replay field must be trivially copyable");
+	auto bytes = reinterpret_cast<const char*>(&value);
+	out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool read_raw(const char*& data, const char* end, T& value)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "Replay field must be trivially copyable");
+	if (static_cast<size_t>(end - data) < sizeof(T))
+	{
+		return false;
+	}
+	std::memcpy(&value, data, sizeof(T));
+	data += sizeof(T);
+	return true;
+}
+} // namespace detail
+
+/**
+ * @brief     .
+ * @brief       ,   .
+ * @brief ,    ,  :
+ * @brief      .
+ * @brief          fields(),
+ * @brief  std::tie  ,    .
+ */
+class replay_recorder
+{
+public:
+	explicit replay_recorder(const std::string& path)
+		: m_file(path, std::ios::binary | std::ios::trunc)
+	{
+		if (!m_file)
+		{
+			throw std::runtime_error("Cannot open replay file " + path);
+		}
+		m_file.write(detail::replay_magic, sizeof(detail::replay_magic));
+		m_file.write(reinterpret_cast<const char*>(&detail::replay_version), sizeof(detail::replay_version));
+	}
+
+	replay_recorder(const replay_recorder&) = delete;
+	replay_recorder& operator=(const replay_recorder&) = delete;
+
+	~replay_recorder()
+	{
+		stop();
+	}
+
+	/**
+	 * @brief        .
+	 * @brief       .
+	 * @see ecs::replay_player::decode()
+	 */
+	template <typename _TEvent>
+	void record(event_bus& bus, std::uint32_t tag)
+	{
+		auto subscription = bus.subscribe<_TEvent>([this, tag](const _TEvent& event) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_inFrame)
+			{
+				return;
+			}
+			detail::write_raw(m_buffer, detail::replay_record::event);
+			detail::write_raw(m_buffer, tag);
+			auto sizeOffset = m_buffer.size();
+			detail::write_raw(m_buffer, std::uint32_t(0));
+
+			_TEvent copy = event;
+			std::apply([this](const auto&... field) { (detail::write_raw(m_buffer, field), ...); }, copy.fields());
+
+			auto size = static_cast<std::uint32_t>(m_buffer.size() - sizeOffset - sizeof(std::uint32_t));
+			std::memcpy(m_buffer.data() + sizeOffset, &size, sizeof(size));
+		});
+		m_subscriptions.push_back({ &bus, subscription });
+	}
+
+	/**
+	 * @brief   ,    .
+	 */
+	void attach(looper& looper)
+	{
+		m_listeners.push_back({ &looper, looper.on_frame_begin([this](float delta_time) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			detail::write_raw(m_buffer, detail::replay_record::frame);
+			detail::write_raw(m_buffer, delta_time);
+			m_inFrame = true;
+		}) });
+		m_listeners.push_back({ &looper, looper.on_frame_end([this](float) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_inFrame = false;
+			if (m_buffer.size() >= flush_threshold)
+			{
+				write_buffer();
+			}
+		}) });
+	}
+
+	/**
+	 * @brief  :         .
+	 * @brief   ,   record()  attach(),    .
+	 * @brief    .
+	 */
+	void stop()
+	{
+		for (auto [bus, subscription] : m_subscriptions)
+		{
+			bus->unsubscribe(subscription);
+		}
+		m_subscriptions.clear();
+		for (auto [looper, listener] : m_listeners)
+		{
+			looper->remove_listener(listener);
+		}
+		m_listeners.clear();
+		flush();
+	}
+
+	/**
+	 * @brief     .
+	 */
+	void flush()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		write_buffer();
+		m_file.flush();
+	}
+
+private:
+	static constexpr size_t flush_threshold = 64 * 1024;
+
+	std::ofstream m_file;
+	std::vector<char> m_buffer;
+	std::mutex m_mutex;
+	bool m_inFrame = false;
+	std::vector<std::pair<event_bus*, size_t>> m_subscriptions;
+	std::vector<std::pair<looper*, size_t>> m_listeners;
+
+	void write_buffer()
+	{
+		m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+		m_buffer.clear();
+	}
+};
+
+/**
+ * @brief   .
+ */
+struct replay_stats
+{
+	size_t ticks = 0;
+	size_t events = 0;
+	double seconds = 0;
+
+	double ticks_per_second() const { return (seconds > 0) ? ticks / seconds : 0; }
+};
+
+/**
+ * @brief    .
+ * @brief     ,     ,
+ * @brief      .
+ */
+class replay_player
+{
+public:
+	explicit replay_player(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+		{
+			throw std::runtime_error("Cannot open replay file " + path);
+		}
+		m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+		char magic[sizeof(detail::replay_magic)];
+		std::uint32_t version = 0;
+		const char* data = m_data.data();
+		const char* end = data + m_data.size();
+		if (!detail::read_raw(data, end, magic) || std::memcmp(magic, detail::replay_magic, sizeof(magic)) != 0
+			|| !detail::read_raw(data, end, version) || version != detail::replay_version)
+		{
+			throw std::runtime_error("Unsupported replay file " + path);
+		}
+		m_begin = static_cast<size_t>(data - m_data.data());
+	}
+
+	/**
+	 * @brief   ,    .
+	 * @brief     .
+	 * @see ecs::replay_recorder::record()
+	 */
+	template <typename _TEvent>
+	void decode(std::uint32_t tag)
+	{
+		m_decoders[tag] = [](const char* data, const char* end, event_bus& bus) {
+			_TEvent event{};
+			bool complete = std::apply([&data, end](auto&... field) { return (detail::read_raw(data, end, field) && ...); },
+				event.fields());
+			if (complete)
+			{
+				bus.publish(event);
+			}
+		};
+	}
+
+	/**
+	 * @brief       ,  .
+	 */
+	replay_stats play(looper& looper)
+	{
+		replay_stats stats;
+		auto& bus = looper.manager().event_bus();
+		const char* data = m_data.data() + m_begin;
+		const char* end = m_data.data() + m_data.size();
+		auto start = std::chrono::steady_clock::now();
+
+		detail::replay_record kind;
+		while (detail::read_raw(data, end, kind))
+		{
+			if (kind == detail::replay_record::frame)
+			{
+				float delta_time = 0;
+				if (!detail::read_raw(data, end, delta_time))
+					break;
+
+				looper.frame(delta_time);
+				++stats.ticks;
+				continue;
+			}
+
+			std::uint32_t tag = 0;
+			std::uint32_t size = 0;
+			if (!detail::read_raw(data, end, tag) || !detail::read_raw(data, end, size)
+				|| static_cast<size_t>(end - data) < size)
+				break;
+
+			auto it = m_decoders.find(tag);
+			if (it != m_decoders.end())
+			{
+				it->second(data, data + size, bus);
+				++stats.events;
+			}
+			data += size;
+		}
+
+		stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return stats;
+	}
+
+private:
+	using decoder = std::function<void(const char*, const char*, event_bus&)>;
+
+	std::vector<char> m_data;
+	size_t m_begin = 0;
+	std::unordered_map<std::uint32_t, decoder> m_decoders;
+};
+} // namespace ecs
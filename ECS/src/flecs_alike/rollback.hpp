@@ -0,0 +1,254 @@
+#pragma once
+
+#include <concepts>
+#include <cstring>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "context.hpp"
+#include "looper.hpp"
+
+namespace ecs
+{
+namespace detail
+{
+template <typename T>
+bool same_value(const T& lhs, const T& rhs)
+{
+	if constexpr (std::equality_comparable<T>)
+	{
+		return lhs == rhs;
+	}
+	else
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Rollback component must be comparable or trivially copyable");
+		return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+	}
+}
+} // namespace detail
+
+/**
+ * @brief     .
+ * @brief   N      
+ * @brief   ,   ,  
+ * @brief   ,    ,   .
+ * @brief     ,
+ * @brief    .
+ */
+template <typename... _TComponents>
+class rollback
+{
+public:
+	explicit rollback(size_t capacity)
+		: m_frames(capacity > 0 ? capacity : 1)
+	{
+	}
+
+	/**
+	 * @brief -   .
+	 * @brief     ,   .
+	 * @see ecs::system_manager::system()
+	 */
+	void capture(context& ctx)
+	{
+		if (m_count == m_frames.size())
+		{
+			m_first = (m_first + 1) % m_frames.size();
+			--m_count;
+		}
+		auto& frame = m_frames[(m_first + m_count) % m_frames.size()];
+		frame.tick = ctx.tick;
+		frame.delta_time = ctx.delta_time;
+		(capture_component<_TComponents>(ctx.entity(), std::get<change_list<_TComponents>>(frame.changes)), ...);
+		++m_count;
+	}
+
+	/**
+	 * @brief        .
+	 * @brief      ,
+	 * @brief      tick + 1.
+	 * @brief      ,  false.
+	 */
+	bool rewind(system_manager& manager, size_t tick)
+	{
+		if (!contains(tick))
+		{
+			return false;
+		}
+		while (newest() != tick)
+		{
+			auto& frame = m_frames[(m_first + m_count - 1) % m_frames.size()];
+			(undo<_TComponents>(std::get<change_list<_TComponents>>(frame.changes)), ...);
+			--m_count;
+		}
+		(restore<_TComponents>(manager.context().entity()), ...);
+		manager.tick(tick + 1);
+		return true;
+	}
+
+	/**
+	 * @brief           
+	 * @brief      .
+	 * @brief        .
+	 * @brief ,        ,
+	 * @brief   false    .
+	 */
+	bool resimulate(looper& looper, size_t from)
+	{
+		auto position = find(from);
+		if (!position || newest() - from != m_count - 1 - *position)
+		{
+			return false;
+		}
+		std::vector<float> deltas;
+		deltas.reserve(m_count - 1 - *position);
+		for (size_t i = *position + 1; i < m_count; ++i)
+		{
+			deltas.push_back(m_frames[(m_first + i) % m_frames.size()].delta_time);
+		}
+		rewind(looper.manager(), from);
+		for (auto delta_time : deltas)
+		{
+			looper.frame(delta_time);
+		}
+		return true;
+	}
+
+	bool contains(size_t tick) const { return find(tick).has_value(); }
+	size_t oldest() const { return m_frames[m_first].tick; }
+	size_t newest() const { return m_frames[(m_first + m_count - 1) % m_frames.size()].tick; }
+	size_t size() const { return m_count; }
+
+private:
+	template <typename T>
+	struct change
+	{
+		size_t entity;
+		std::optional<T> before;
+	};
+
+	template <typename T>
+	using change_list = std::vector<change<T>>;
+
+	struct frame
+	{
+		size_t tick = 0;
+		float delta_time = 0;
+		std::tuple<change_list<_TComponents>...> changes;
+	};
+
+	template <typename T>
+	struct track
+	{
+		std::vector<std::optional<T>> latest;
+		std::vector<size_t> seen;
+	};
+
+	std::vector<frame> m_frames;
+	size_t m_first = 0;
+	size_t m_count = 0;
+	size_t m_stamp = 0;
+	std::tuple<track<_TComponents>...> m_tracks;
+
+	/**
+	 * @brief       .
+	 * @brief       ,    .
+	 */
+	std::optional<size_t> find(size_t tick) const
+	{
+		for (size_t i = 0; i < m_count; ++i)
+		{
+			if (m_frames[(m_first + i) % m_frames.size()].tick == tick)
+			{
+				return i;
+			}
+		}
+		return std::nullopt;
+	}
+
+	template <typename T>
+	void capture_component(entity_manager& em, change_list<T>& out)
+	{
+		auto& state = std::get<track<T>>(m_tracks);
+		out.clear();
+		++m_stamp;
+
+		auto [begin, end] = em.all_entities();
+		for (auto it = begin; it != end; ++it)
+		{
+			if (!it->is_valid())
+				continue;
+
+			auto component = it->template get<T>();
+			if (!component)
+				continue;
+
+			auto ID = it->ID();
+			if (ID >= state.latest.size())
+			{
+				state.latest.resize(ID + 1);
+				state.seen.resize(ID + 1, 0);
+			}
+			state.seen[ID] = m_stamp;
+
+			auto& latest = state.latest[ID];
+			if (latest && detail::same_value(*latest, *component))
+				continue;
+
+			out.push_back({ ID, latest });
+			latest = *component;
+		}
+
+		for (size_t ID = 0; ID < state.latest.size(); ++ID)
+		{
+			if (state.latest[ID] && state.seen[ID] != m_stamp)
+			{
+				out.push_back({ ID, state.latest[ID] });
+				state.latest[ID].reset();
+			}
+		}
+	}
+
+	template <typename T>
+	void undo(const change_list<T>& frameChanges)
+	{
+		auto& state = std::get<track<T>>(m_tracks);
+		for (auto it = frameChanges.rbegin(); it != frameChanges.rend(); ++it)
+		{
+			state.latest[it->entity] = it->before;
+		}
+	}
+
+	template <typename T>
+	void restore(entity_manager& em)
+	{
+		auto& state = std::get<track<T>>(m_tracks);
+		auto [begin, end] = em.all_entities();
+		for (auto it = begin; it != end; ++it)
+		{
+			if (!it->is_valid())
+				continue;
+
+			auto ID = it->ID();
+			const T* value = (ID < state.latest.size() && state.latest[ID])
+				? &*state.latest[ID]
+				: nullptr;
+			auto component = it->template get<T>();
+			if (value && component)
+			{
+				*component = *value;
+			}
+			else if (value)
+			{
+				it->template add<T>(*value);
+			}
+			else if (component)
+			{
+				it->template remove<T>();
+			}
+		}
+	}
+};
+} // namespace ecs
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace ecs
+{
+/**
+ * @brief   .
+ * @brief map -      ( ),
+ * @brief sparse -   ,    .
+ */
+enum class storage_policy
+{
+	map,
+	sparse,
+};
+
+/**
+ * @brief     .
+ * @brief       
+ * @brief   storage_policy::sparse.
+ */
+template <typename T>
+struct component_storage
+{
+	static constexpr storage_policy policy = storage_policy::map;
+};
+
+template <typename T>
+constexpr bool is_sparse_v = component_storage<T>::policy == storage_policy::sparse;
+
+/**
+ * @brief    
+ */
+class sparse_set_base
+{
+public:
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+	virtual ~sparse_set_base() = default;
+
+	bool contains(size_t entity) const
+	{
+		return entity < m_sparse.size() && m_sparse[entity] != npos;
+	}
+
+	/**
+	 * @brief     .
+	 * @brief     ,    .
+	 */
+	virtual void* get(size_t entity) = 0;
+
+	virtual void remove(size_t entity) = 0;
+
+	virtual void clear() = 0;
+
+	/**
+	 * @brief       .
+	 */
+	const std::vector<size_t>& entities() const { return m_dense; }
+
+	size_t size() const { return m_dense.size(); }
+
+protected:
+	std::vector<size_t> m_sparse;
+	std::vector<size_t> m_dense;
+};
+
+/**
+ * @brief    .
+ * @brief     ,      O(1).
+ * @brief       ,
+ * @brief      .
+ */
+template <typename T>
+class sparse_set : public sparse_set_base
+{
+public:
+	/**
+	 * @brief       .
+	 */
+	template <typename... Args>
+	T& emplace(size_t entity, Args&&... args)
+	{
+		if (contains(entity))
+		{
+			auto& value = m_values[m_sparse[entity]];
+			value = T(std::forward<Args>(args)...);
+			return value;
+		}
+		if (entity >= m_sparse.size())
+		{
+			m_sparse.resize(entity + 1, npos);
+		}
+		m_sparse[entity] = m_dense.size();
+		m_dense.push_back(entity);
+		return m_values.emplace_back(std::forward<Args>(args)...);
+	}
+
+	void* get(size_t entity) override
+	{
+		return contains(entity) ? &m_values[m_sparse[entity]] : nullptr;
+	}
+
+	void remove(size_t entity) override
+	{
+		if (!contains(entity))
+		{
+			return;
+		}
+		auto index = m_sparse[entity];
+		auto last = m_dense.back();
+		if (index != m_dense.size() - 1)
+		{
+			m_values[index] = std::move(m_values.back());
+			m_dense[index] = last;
+			m_sparse[last] = index;
+		}
+		m_values.pop_back();
+		m_dense.pop_back();
+		m_sparse[entity] = npos;
+	}
+
+	void clear() override
+	{
+		m_values.clear();
+		m_dense.clear();
+		m_sparse.clear();
+	}
+
+	typename std::vector<T>::iterator begin() { return m_values.begin(); }
+	typename std::vector<T>::iterator end() { return m_values.end(); }
+
+private:
+	std::vector<T> m_values;
+};
+
+namespace detail
+{
+inline size_t next_sparse_id()
+{
+	static std::atomic<size_t> counter = 0;
+	return counter++;
+}
+
+template <typename T>
+size_t sparse_id()
+{
+	static const size_t ID = next_sparse_id();
+	return ID;
+}
+} // namespace detail
+
+/**
+ * @brief        .
+ */
+class sparse_registry
+{
+public:
+	template <typename T>
+	sparse_set<T>& set()
+	{
+		auto ID = detail::sparse_id<T>();
+		if (ID >= m_sets.size())
+		{
+			m_sets.resize(ID + 1);
+		}
+		if (!m_sets[ID])
+		{
+			m_sets[ID] = std::make_unique<sparse_set<T>>();
+			m_byType[typeid(T)] = m_sets[ID].get();
+		}
+		return static_cast<sparse_set<T>&>(*m_sets[ID]);
+	}
+
+	/**
+	 * @brief      .
+	 * @brief       ,    .
+	 */
+	sparse_set_base* find(std::type_index type)
+	{
+		auto it = m_byType.find(type);
+		return (it != m_byType.end()) ? it->second : nullptr;
+	}
+
+	const std::unordered_map<std::type_index, sparse_set_base*>& sets() const { return m_byType; }
+
+	void clear()
+	{
+		for (auto& set : m_sets)
+		{
+			if (set)
+				set->clear();
+		}
+	}
+
+private:
+	std::vector<std::unique_ptr<sparse_set_base>> m_sets;
+	std::unordered_map<std::type_index, sparse_set_base*> m_byType;
+};
+} // namespace ecs
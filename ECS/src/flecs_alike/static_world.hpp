@@ -0,0 +1,268 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "context.hpp"
+
+namespace ecs
+{
+namespace detail
+{
+/**
+ * @brief         .
+ */
+template <typename T, typename... _TTypes>
+struct type_index_of;
+
+template <typename T, typename... _TTypes>
+struct type_index_of<T, T, _TTypes...> : std::integral_constant<size_t, 0>
+{
+};
+
+template <typename T, typename _TFirst, typename... _TTypes>
+struct type_index_of<T, _TFirst, _TTypes...> : std::integral_constant<size_t, 1 + type_index_of<T, _TTypes...>::value>
+{
+};
+
+/**
+ * @brief      
+ * @brief   ,     .
+ */
+template <typename... _TArgs>
+struct system_signature
+{
+	static constexpr bool context_needed = false;
+	using components = std::tuple<std::remove_cvref_t<_TArgs>...>;
+};
+
+template <typename... _TArgs>
+struct system_signature<context&, _TArgs...>
+{
+	static constexpr bool context_needed = true;
+	using components = std::tuple<std::remove_cvref_t<_TArgs>...>;
+};
+
+template <typename _TFn>
+struct system_traits : system_traits<decltype(&_TFn::operator())>
+{
+};
+
+template <typename R, typename... _TArgs>
+struct system_traits<R (*)(_TArgs...)> : system_signature<_TArgs...>
+{
+};
+
+template <typename R, typename C, typename... _TArgs>
+struct system_traits<R (C::*)(_TArgs...)> : system_signature<_TArgs...>
+{
+};
+
+template <typename R, typename C, typename... _TArgs>
+struct system_traits<R (C::*)(_TArgs...) const> : system_signature<_TArgs...>
+{
+};
+} // namespace detail
+
+/**
+ * @brief     ,    .
+ * @brief      ,    -  .
+ * @brief      ,
+ * @brief    -   .
+ * @brief    ,    ecs::entity_manager.
+ */
+template <typename... _TComponents>
+class static_world
+{
+	static_assert(sizeof...(_TComponents) <= 64, "Too many components for a 64-bit mask");
+
+public:
+	using mask_type = std::uint64_t;
+
+	/**
+	 * @brief       .
+	 */
+	template <typename T>
+	static constexpr mask_type bit()
+	{
+		return mask_type(1) << detail::type_index_of<T, _TComponents...>::value;
+	}
+
+	/**
+	 * @brief        .
+	 * @brief     .
+	 */
+	size_t create()
+	{
+		if (!m_free.empty())
+		{
+			auto ID = m_free.back();
+			m_free.pop_back();
+			m_alive[ID] = true;
+			return ID;
+		}
+
+		auto ID = m_masks.size();
+		m_masks.push_back(0);
+		m_alive.push_back(true);
+		std::apply([](auto&... column) { (column.emplace_back(), ...); }, m_columns);
+		return ID;
+	}
+
+	/**
+	 * @brief       .
+	 */
+	void destroy(size_t ID)
+	{
+		if (!is_valid(ID))
+		{
+			return;
+		}
+		std::apply([ID](auto&... column) { (column[ID].reset(), ...); }, m_columns);
+		m_masks[ID] = 0;
+		m_alive[ID] = false;
+		m_free.push_back(ID);
+	}
+
+	bool is_valid(size_t ID) const { return ID < m_alive.size() && m_alive[ID]; }
+
+	/**
+	 * @brief        .
+	 * @brief       .
+	 */
+	template <typename T, typename... Args>
+	T& add(size_t ID, Args&&... args)
+	{
+		m_masks[ID] |= bit<T>();
+		return column<T>()[ID].emplace(std::forward<Args>(args)...);
+	}
+
+	template <typename T>
+	void remove(size_t ID)
+	{
+		m_masks[ID] &= ~bit<T>();
+		column<T>()[ID].reset();
+	}
+
+	/**
+	 * @brief        .
+	 */
+	template <typename T>
+	T* get(size_t ID)
+	{
+		return has<T>(ID) ? &*column<T>()[ID] : nullptr;
+	}
+
+	template <typename T>
+	bool has(size_t ID) const
+	{
+		return ID < m_masks.size() && (m_masks[ID] & bit<T>()) != 0;
+	}
+
+	/**
+	 * @brief   ,   .
+	 */
+	size_t capacity() const { return m_masks.size(); }
+
+	/**
+	 * @brief     ,      .
+	 * @brief      .
+	 */
+	template <typename... _TQuery, typename _TFn>
+	void each(context& ctx, _TFn&& __fn)
+	{
+		constexpr mask_type required = (bit<_TQuery>() | ... | mask_type(0));
+		auto columns = std::tie(column<_TQuery>()...);
+		for (size_t ID = 0; ID < m_masks.size(); ++ID)
+		{
+			if ((m_masks[ID] & required) != required)
+				continue;
+
+			ctx.entity_id = ID;
+			std::apply([&](auto&... column) { __fn(*column[ID]...); }, columns);
+		}
+	}
+
+private:
+	std::tuple<std::vector<std::optional<_TComponents>>...> m_columns;
+	std::vector<mask_type> m_masks;
+	std::vector<bool> m_alive;
+	std::vector<size_t> m_free;
+
+	template <typename T>
+	std::vector<std::optional<T>>& column()
+	{
+		return std::get<detail::type_index_of<T, _TComponents...>::value>(m_columns);
+	}
+};
+
+/**
+ * @brief   ,    .
+ * @brief  -        ,
+ * @brief    ecs::system_manager: (context&, ...)  (...).
+ * @brief    ,     ,
+ * @brief         .
+ * @brief        std::function.
+ */
+template <typename... _TSystems>
+class static_pipeline
+{
+public:
+	explicit static_pipeline(_TSystems... systems)
+		: m_systems(std::move(systems)...)
+	{
+	}
+
+	/**
+	 * @brief      .
+	 * @brief       .
+	 * @see ecs::context::frame_alloc()
+	 */
+	template <typename _TWorld>
+	void update(_TWorld& world, context& ctx, float delta_time)
+	{
+		ctx.delta_time = delta_time;
+		ctx.tick = m_tick;
+		std::apply([&](auto&... system) { (run(world, ctx, system), ...); }, m_systems);
+		++m_tick;
+		ctx.frame_alloc().reset();
+	}
+
+	size_t tick() const { return m_tick; }
+
+private:
+	std::tuple<_TSystems...> m_systems;
+	size_t m_tick = 0;
+
+	template <typename _TWorld, typename _TSystem>
+	static void run(_TWorld& world, context& ctx, _TSystem& system)
+	{
+		using traits = detail::system_traits<_TSystem>;
+		run(world, ctx, system, std::bool_constant<traits::context_needed>(), static_cast<typename traits::components*>(nullptr));
+	}
+
+	template <typename _TWorld, typename _TSystem, bool _ContextNeeded, typename... _TQuery>
+	static void run(_TWorld& world, context& ctx, _TSystem& system, std::bool_constant<_ContextNeeded>, std::tuple<_TQuery...>*)
+	{
+		if constexpr (sizeof...(_TQuery) == 0)
+		{
+			if constexpr (_ContextNeeded)
+				system(ctx);
+			else
+				system();
+		}
+		else if constexpr (_ContextNeeded)
+		{
+			world.template each<_TQuery...>(ctx, [&](_TQuery&... components) { system(ctx, components...); });
+		}
+		else
+		{
+			world.template each<_TQuery...>(ctx, [&](_TQuery&... components) { system(components...); });
+		}
+	}
+};
+} // namespace ecs
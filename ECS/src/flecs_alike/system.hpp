@@ -28,9 +28,91 @@ public:
 
 	void add_filter(std::type_index filter) { m_filters.push_back(filter); }
 
+	void interval(size_t ticks) { m_interval = (ticks > 0) ? ticks : 1; }
+	size_t interval() const { return m_interval; }
+
+	void phase(size_t tick) { m_phase = tick % m_interval; }
+
+	void budget(size_t entities) { m_budget = entities; }
+	size_t budget() const { return m_budget; }
+
+	void cursor(size_t index) { m_cursor = index; }
+	size_t cursor() const { return m_cursor; }
+
+	/**
+	 * @brief ,       .
+	 */
+	bool due(size_t tick) const { return tick % m_interval == m_phase; }
+
+	/**
+	 * @brief   ,     .
+	 */
+	void accumulate(float delta_time)
+	{
+		m_elapsed += delta_time;
+		m_clock += delta_time;
+	}
+
+	/**
+	 * @brief      .
+	 */
+	float consume()
+	{
+		float elapsed = m_elapsed;
+		m_elapsed = 0;
+		return elapsed;
+	}
+
+	/**
+	 * @brief       .
+	 * @see ecs::system_impl::elapsed_for()
+	 */
+	void begin_sweep()
+	{
+		++m_sweepNumber;
+		m_previousSweep = m_sweep;
+		m_sweep = m_clock;
+	}
+
+	/**
+	 * @brief  ,        ,
+	 * @brief    .
+	 * @brief  ,     ,      .
+	 */
+	float elapsed_for(size_t entity)
+	{
+		if (entity >= m_runs.size())
+		{
+			m_runs.resize(entity + 1);
+		}
+		auto& run = m_runs[entity];
+		auto last = (run.sweep != 0 && run.sweep + 1 == m_sweepNumber) ? run.time : m_previousSweep;
+		run = { m_clock, m_sweepNumber };
+		return static_cast<float>(m_clock - last);
+	}
+
 private:
 	std::string m_name;
 	std::vector<std::type_index> m_filters;
 	callback_type m_callback;
+
+	size_t m_interval = 1;
+	size_t m_phase = 0;
+	size_t m_budget = 0;
+	size_t m_cursor = 0;
+	float m_elapsed = 0;
+
+	struct entity_run
+	{
+		double time = 0;
+		size_t sweep = 0;
+	};
+
+	//       ,  -  
+	double m_clock = 0;
+	double m_sweep = 0;
+	double m_previousSweep = 0;
+	size_t m_sweepNumber = 0;
+	std::vector<entity_run> m_runs;
 };
 } // namespace ecs
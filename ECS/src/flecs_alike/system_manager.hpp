@@ -1,13 +1,17 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
+#include "component_hooks.hpp"
 #include "context.hpp"
 #include "entity_manager.hpp"
+#include "observer.hpp"
 #include "system.hpp"
 
 namespace ecs
@@ -58,6 +62,28 @@ public:
 		return *this;
 	}
 
+	/**
+	 * @brief        .
+	 * @brief        .
+	 * @brief    ,     .
+	 */
+	system_builder& interval(size_t ticks)
+	{
+		m_system.interval(ticks);
+		return *this;
+	}
+
+	/**
+	 * @brief   ,    .
+	 * @brief       .
+	 * @brief  delta_time         .
+	 */
+	system_builder& budget(size_t entities)
+	{
+		m_system.budget(entities);
+		return *this;
+	}
+
 	/**
 	 * @brief      -.
 	 * @brief -       ,
@@ -99,7 +125,7 @@ public:
 					},
 					ctx, components);
 			else
-				std::invoke(callback);
+				(instance.*callback)();
 		});
 	}
 
@@ -122,7 +148,7 @@ public:
 					},
 					ctx, components);
 			else
-				std::invoke(callback);
+				(instance.*callback)(ctx);
 		});
 	}
 
@@ -156,7 +182,115 @@ private:
 	system_storage& set_each_callback(_TFn&& _function)
 	{
 		m_system.callback(std::forward<_TFn>(_function));
-		m_manager.get_systems().push_back(std::make_unique<system_impl>(std::move(m_system)));
+
+		auto& systems = m_manager.get_systems();
+		auto sameInterval = std::count_if(systems.begin(), systems.end(),
+			[this](const auto& system) { return system->interval() == m_system.interval(); });
+		m_system.phase(static_cast<size_t>(sameInterval));
+
+		systems.push_back(std::make_unique<system_impl>(std::move(m_system)));
+		return m_manager;
+	}
+};
+
+class observer_storage
+{
+public:
+	virtual ~observer_storage() = default;
+	virtual std::unordered_map<std::type_index, std::vector<std::unique_ptr<observer_impl>>>& get_observers() = 0;
+};
+
+/**
+ * @brief      
+ */
+template <typename _TComponent>
+class observer_builder
+{
+public:
+	observer_builder(observer_storage& manager, std::string name)
+		: m_observer{ std::move(name), typeid(_TComponent) }
+		, m_manager(manager)
+	{
+	}
+
+	/**
+	 * @brief      .
+	 */
+	observer_builder& on_add()
+	{
+		m_observer.add_event(observer_event::on_add);
+		return *this;
+	}
+
+	/**
+	 * @brief         .
+	 * @brief      .
+	 */
+	observer_builder& on_remove()
+	{
+		m_observer.add_event(observer_event::on_remove);
+		return *this;
+	}
+
+	/**
+	 * @brief       .
+	 */
+	observer_builder& on_set()
+	{
+		m_observer.add_event(observer_event::on_set);
+		return *this;
+	}
+
+	/**
+	 * @brief      .
+	 * @brief         .
+	 * @see ecs::system_manager::flush_observers()
+	 */
+	observer_builder& deferred()
+	{
+		m_observer.deferred(true);
+		return *this;
+	}
+
+	/**
+	 * @brief      -.
+	 * @brief -     .
+	 * @see ecs::system_manager::observer()
+	 */
+	template <typename _TFn>
+	observer_storage& each(_TFn&& __fn)
+	{
+		return set_each_callback([callback = std::forward<_TFn>(__fn)](context& ctx, void* component) {
+			std::invoke(callback, *static_cast<_TComponent*>(component));
+		});
+	}
+
+	/**
+	 * @brief      -.
+	 * @brief -      ,
+	 * @brief      .
+	 * @see ecs::system_manager::observer()
+	 */
+	template <typename _TFn>
+	observer_storage& each(_TFn&& __fn, bool context_needed)
+	{
+		return set_each_callback([callback = std::forward<_TFn>(__fn)](context& ctx, void* component) {
+			std::invoke(callback, ctx, *static_cast<_TComponent*>(component));
+		});
+	}
+
+private:
+	observer_impl m_observer;
+	observer_storage& m_manager;
+
+	template <typename _TFn>
+	observer_storage& set_each_callback(_TFn&& _function)
+	{
+		m_observer.callback(std::forward<_TFn>(_function));
+		m_observer.retain([](void* component) -> std::shared_ptr<void> {
+			return std::make_shared<_TComponent>(*static_cast<_TComponent*>(component));
+		});
+		m_manager.get_observers()[m_observer.component()].push_back(std::make_unique<observer_impl>(std::move(m_observer)));
 		return m_manager;
 	}
 };
@@ -164,18 +298,28 @@ private:
 /**
  * @brief      
  */
-class system_manager : private system_storage
+class system_manager
+	: private system_storage
+	, private observer_storage
+	, private component_hooks
 {
 public:
 	system_manager(entity_manager& em)
 		: m_entityManager(em)
 		, m_context(em, m_event_bus)
 	{
+		m_entityManager.hooks(this);
+	}
+
+	~system_manager() override
+	{
+		m_entityManager.hooks(nullptr);
 	}
 
 	/**
 	 * @brief     .
 	 * @brief      .
+	 * @brief        .
 	 * @see ecs::system_builder::each()
 	 */
 	template <typename... _TComponents>
@@ -184,62 +328,276 @@ public:
 		return system_builder<_TComponents...>(*this, std::move(name));
 	}
 
+	/**
+	 * @brief     .
+	 * @brief    ,    .
+	 * @see ecs::observer_builder::each()
+	 */
+	template <typename _TComponent>
+	auto observer(std::string name)
+	{
+		return observer_builder<_TComponent>(*this, std::move(name));
+	}
+
 	/**
 	 * @brief   
 	 */
 	ecs::event_bus& event_bus() { return m_event_bus; }
 
 	/**
-	 * @brief  -   
+	 * @brief  ,   .
+	 * @brief     .
+	 * @see ecs::context::set_resource()
+	 */
+	ecs::context& context() { return m_context; }
+
+	/**
+	 * @brief  -      .
+	 * @brief      ,
+	 * @brief  -    .
+	 * @brief      .
+	 * @brief       
+	 * @brief      .
+	 * @see ecs::system_builder::interval()
+	 * @see ecs::system_builder::budget()
+	 * @see ecs::context::frame_alloc()
+	 * @see ecs::event_bus::collect()
 	 */
 	void update(float delta_time)
 	{
-		auto [begin, end] = m_entityManager.all_entities();
-		if (begin == end)
+		m_context.tick = m_tick;
+		for (const auto& system : m_systems)
 		{
-			return;
-		}
-		for (auto& entity = begin; entity != end; ++entity)
-		{
-			if (!entity->is_valid())
+			system->accumulate(delta_time);
+			if (!system->due(m_tick))
 				continue;
 
-			for (const auto& system : m_systems)
+			m_context.delta_time = system->consume();
+			m_components.clear();
+			if (system->filters().empty())
 			{
-				std::vector<void*> components;
-				components.reserve(system->filters().size());
-				bool hasAll = true;
-				for (const auto& filter : system->filters())
-				{
-					if (entity->has(filter))
-					{
-						components.push_back(entity->get(filter));
-					}
-					else
-					{
-						hasAll = false;
-						break;
-					}
-				}
-				if (hasAll && components.size() == system->filters().size())
-				{
-					m_context.entity_id = entity->ID();
-					m_context.delta_time = delta_time;
-					system->callback()(m_context, components);
-				}
+				system->callback()(m_context, m_components);
+				continue;
 			}
+
+			if (system->budget() > 0 && system->cursor() == 0)
+			{
+				system->begin_sweep();
+			}
+			auto driver = smallest_sparse_set(*system);
+			(driver)
+				? run_sparse(*system, *driver, m_components)
+				: run_all(*system, m_components);
 		}
+		++m_tick;
+		flush_observers();
+		m_event_bus.collect();
+		m_context.frame_alloc().reset();
+	}
+
+	/**
+	 * @brief    .
+	 */
+	size_t tick() const { return m_tick; }
+
+	/**
+	 * @brief    .
+	 * @see ecs::rollback::rewind()
+	 */
+	void tick(size_t tick) { m_tick = tick; }
+
+	/**
+	 * @brief       .
+	 * @brief      .
+	 */
+	void flush_observers()
+	{
+		m_flushing.swap(m_deferred);
+		for (const auto& event : m_flushing)
+		{
+			invoke(*event.observer, event.entity_id, event.component.get());
+		}
+		m_flushing.clear();
 	}
 
 private:
 	entity_manager& m_entityManager;
 	std::vector<std::unique_ptr<system_impl>> m_systems;
-	context m_context;
+	ecs::context m_context;
 	ecs::event_bus m_event_bus;
+	size_t m_tick = 0;
+	//    ,   
+	std::vector<void*> m_components;
+
+	struct deferred_event
+	{
+		observer_impl* observer;
+		size_t entity_id;
+		std::shared_ptr<void> component;
+	};
+
+	std::unordered_map<std::type_index, std::vector<std::unique_ptr<observer_impl>>> m_observers;
+	std::vector<deferred_event> m_deferred;
+	std::vector<deferred_event> m_flushing;
 
 	std::vector<std::unique_ptr<system_impl>>& get_systems() override
 	{
 		return m_systems;
 	}
+
+	std::unordered_map<std::type_index, std::vector<std::unique_ptr<observer_impl>>>& get_observers() override
+	{
+		return m_observers;
+	}
+
+	void on_add(entity& e, std::type_index type, const std::shared_ptr<void>& component) override
+	{
+		notify(observer_event::on_add, e, type, component);
+	}
+
+	void on_remove(entity& e, std::type_index type, const std::shared_ptr<void>& component) override
+	{
+		notify(observer_event::on_remove, e, type, component);
+	}
+
+	void on_set(entity& e, std::type_index type, const std::shared_ptr<void>& component) override
+	{
+		notify(observer_event::on_set, e, type, component);
+	}
+
+	/**
+	 * @brief    .
+	 * @brief            :
+	 * @brief         ,
+	 * @brief           .
+	 */
+	void run_all(system_impl& system, std::vector<void*>& components)
+	{
+		if (system.budget() == 0)
+		{
+			auto [begin, end] = m_entityManager.all_entities();
+			for (auto it = begin; it != end; ++it)
+			{
+				run_on(system, *it, components);
+			}
+			return;
+		}
+
+		size_t processed = 0;
+		size_t ID = system.cursor();
+		auto entity = m_entityManager.get(ID);
+		while (entity && processed < system.budget())
+		{
+			if (run_on(system, *entity, components))
+			{
+				++processed;
+			}
+			entity = m_entityManager.get(++ID);
+		}
+		system.cursor(entity ? ID : 0);
+	}
+
+	/**
+	 * @brief         .
+	 * @brief    ,     
+	 * @brief     .
+	 */
+	void run_sparse(system_impl& system, const sparse_set_base& set, std::vector<void*>& components)
+	{
+		const auto& entities = set.entities();
+		size_t processed = 0;
+		size_t index = (system.cursor() > 0) ? system.cursor() : entities.size();
+		while (index > 0)
+		{
+			if (system.budget() > 0 && processed == system.budget())
+				break;
+
+			index = std::min(index, entities.size());
+			if (index == 0)
+				break;
+
+			--index;
+			auto entity = m_entityManager.get(entities[index]);
+			if (entity && run_on(system, *entity, components))
+			{
+				++processed;
+			}
+		}
+		system.cursor(index);
+	}
+
+	bool run_on(system_impl& system, entity& entity, std::vector<void*>& components)
+	{
+		if (!entity.is_valid())
+		{
+			return false;
+		}
+		components.clear();
+		for (const auto& filter : system.filters())
+		{
+			auto component = entity.get(filter);
+			if (!component)
+			{
+				return false;
+			}
+			components.push_back(component);
+		}
+		m_context.entity_id = entity.ID();
+		if (system.budget() > 0)
+		{
+			m_context.delta_time = system.elapsed_for(entity.ID());
+		}
+		system.callback()(m_context, components);
+		return true;
+	}
+
+	sparse_set_base* smallest_sparse_set(const system_impl& system)
+	{
+		sparse_set_base* smallest = nullptr;
+		for (const auto& filter : system.filters())
+		{
+			auto set = m_entityManager.sparse(filter);
+			if (set && (!smallest || set->size() < smallest->size()))
+			{
+				smallest = set;
+			}
+		}
+		return smallest;
+	}
+
+	void notify(observer_event event, entity& e, std::type_index type, const std::shared_ptr<void>& component)
+	{
+		auto it = m_observers.find(type);
+		if (it == m_observers.end())
+		{
+			return;
+		}
+		for (const auto& observer : it->second)
+		{
+			if (!observer->listens(event))
+				continue;
+
+			if (observer->deferred())
+			{
+				//         
+				auto retained = (component.use_count() > 0)
+					? component
+					: observer->retain(component.get());
+				m_deferred.push_back({ observer.get(), e.ID(), std::move(retained) });
+			}
+			else
+			{
+				invoke(*observer, e.ID(), component.get());
+			}
+		}
+	}
+
+	void invoke(const observer_impl& observer, size_t entity_id, void* component)
+	{
+		auto previous = m_context.entity_id;
+		m_context.entity_id = entity_id;
+		observer.callback()(m_context, component);
+		m_context.entity_id = previous;
+	}
 };
 } // namespace ecs
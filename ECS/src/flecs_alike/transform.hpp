@@ -0,0 +1,106 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "context.hpp"
+#include "hierarchy.hpp"
+
+namespace ecs
+{
+/**
+ * @brief    .
+ * @see ecs::transform_propagation
+ */
+struct offset
+{
+	float x, y;
+};
+
+/**
+ * @brief        .
+ * @brief      
+ * @brief      .
+ * @brief      x  y.
+ */
+template <typename _TPosition>
+class transform_propagation
+{
+public:
+	/**
+	 * @brief -   .
+	 * @see ecs::system_manager::system()
+	 */
+	void update(context& ctx)
+	{
+		auto& em = ctx.entity();
+		const auto& nodes = em.hierarchy().nodes();
+		if (m_hierarchyVersion != em.hierarchy().version()
+			|| m_positionVersion != em.component_version<_TPosition>()
+			|| m_offsetVersion != em.component_version<ecs::offset>())
+		{
+			resolve(em, nodes);
+		}
+
+		for (auto& node : m_cache)
+		{
+			if (!node.position || !node.offset || !node.parent_position)
+				continue;
+
+			const auto& parent = *node.parent_position;
+			const auto& offset = *node.offset;
+			if (node.parent_x == parent.x && node.parent_y == parent.y
+				&& node.offset_x == offset.x && node.offset_y == offset.y)
+				continue;
+
+			node.position->x = parent.x + offset.x;
+			node.position->y = parent.y + offset.y;
+			node.parent_x = parent.x;
+			node.parent_y = parent.y;
+			node.offset_x = offset.x;
+			node.offset_y = offset.y;
+		}
+	}
+
+private:
+	struct cached_node
+	{
+		_TPosition* position;
+		ecs::offset* offset;
+		_TPosition* parent_position;
+		float parent_x, parent_y;
+		float offset_x, offset_y;
+	};
+
+	std::vector<cached_node> m_cache;
+	size_t m_hierarchyVersion = static_cast<size_t>(-1);
+	size_t m_positionVersion = static_cast<size_t>(-1);
+	size_t m_offsetVersion = static_cast<size_t>(-1);
+
+	void resolve(entity_manager& em, const std::vector<hierarchy_node>& nodes)
+	{
+		m_cache.clear();
+		m_cache.reserve(nodes.size());
+		for (const auto& node : nodes)
+		{
+			auto child = em.get(node.entity);
+			auto parent = em.get(node.parent);
+			bool alive = child && parent && child->is_valid() && parent->is_valid();
+
+			cached_node cached{};
+			cached.position = alive ? child->get<_TPosition>() : nullptr;
+			cached.offset = alive ? child->get<ecs::offset>() : nullptr;
+			cached.parent_position = alive ? parent->get<_TPosition>() : nullptr;
+			if (cached.parent_position)
+			{
+				// NaN     ,    
+				cached.parent_x = std::numeric_limits<float>::quiet_NaN();
+			}
+			m_cache.push_back(cached);
+		}
+		m_hierarchyVersion = em.hierarchy().version();
+		m_positionVersion = em.component_version<_TPosition>();
+		m_offsetVersion = em.component_version<ecs::offset>();
+	}
+};
+} // namespace ecs
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "entity_manager.hpp"
+#include "looper.hpp"
+#include "system_manager.hpp"
+
+namespace ecs
+{
+/**
+ * @brief   .
+ * @brief   ,      .
+ */
+struct world_metrics
+{
+	std::atomic<std::uint64_t> ticks = 0;
+	std::atomic<std::uint64_t> overruns = 0;
+	// ,  - ,       
+	std::atomic<std::uint64_t> skipped_ticks = 0;
+	std::atomic<std::uint64_t> last_tick_us = 0;
+	std::atomic<std::uint64_t> max_tick_us = 0;
+	std::atomic<std::uint64_t> total_tick_us = 0;
+
+	double average_tick_us() const
+	{
+		auto count = ticks.load();
+		return (count > 0) ? static_cast<double>(total_tick_us.load()) / count : 0;
+	}
+};
+
+/**
+ * @brief   .
+ * @brief        ,
+ * @brief       .
+ */
+class world
+{
+public:
+	world()
+		: m_systems(m_entities)
+		, m_looper(m_systems)
+	{
+	}
+
+	world(const world&) = delete;
+	world& operator=(const world&) = delete;
+
+	entity_manager& entities() { return m_entities; }
+	system_manager& systems() { return m_systems; }
+	ecs::looper& looper() { return m_looper; }
+	const world_metrics& metrics() const { return m_metrics; }
+
+	/**
+	 * @brief  ,   .
+	 */
+	void skipped(std::uint64_t ticks) { m_metrics.skipped_ticks.fetch_add(ticks, std::memory_order_relaxed); }
+
+	/**
+	 * @brief       .
+	 */
+	void tick(float delta_time, std::chrono::microseconds budget)
+	{
+		auto start = std::chrono::steady_clock::now();
+		m_looper.frame(delta_time);
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+		auto us = static_cast<std::uint64_t>(elapsed.count());
+		m_metrics.ticks.fetch_add(1, std::memory_order_relaxed);
+		m_metrics.last_tick_us.store(us, std::memory_order_relaxed);
+		m_metrics.total_tick_us.fetch_add(us, std::memory_order_relaxed);
+		if (us > m_metrics.max_tick_us.load(std::memory_order_relaxed))
+		{
+			m_metrics.max_tick_us.store(us, std::memory_order_relaxed);
+		}
+		if (elapsed > budget)
+		{
+			m_metrics.overruns.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+private:
+	entity_manager m_entities;
+	system_manager m_systems;
+	ecs::looper m_looper;
+	world_metrics m_metrics;
+};
+
+/**
+ * @brief         .
+ * @brief       ( i -   i % N),
+ * @brief        
+ * @brief     .
+ */
+class world_host
+{
+public:
+	explicit world_host(size_t threads = std::thread::hardware_concurrency())
+		: m_threadCount(std::max<size_t>(threads, 1))
+	{
+	}
+
+	world_host(const world_host&) = delete;
+	world_host& operator=(const world_host&) = delete;
+
+	~world_host()
+	{
+		stop();
+	}
+
+	/**
+	 * @brief        .
+	 * @brief    .
+	 * @see ecs::world_host::start()
+	 */
+	world& create_world(const std::function<void(world&)>& setup = nullptr)
+	{
+		if (m_running)
+		{
+			throw std::logic_error("Cannot create a world while the host is running");
+		}
+		m_worlds.push_back(std::make_unique<world>());
+		if (setup)
+		{
+			setup(*m_worlds.back());
+		}
+		return *m_worlds.back();
+	}
+
+	/**
+	 * @brief       .
+	 * @brief      ,   ,
+	 * @brief      world_metrics::skipped_ticks
+	 * @brief    .
+	 */
+	void start(unsigned int tickRate)
+	{
+		if (m_running.exchange(true))
+		{
+			return;
+		}
+		auto threads = std::min(m_threadCount, std::max<size_t>(m_worlds.size(), 1));
+		for (size_t i = 0; i < threads; ++i)
+		{
+			m_threads.emplace_back([this, i, threads, tickRate]() { run(i, threads, tickRate); });
+		}
+	}
+
+	/**
+	 * @brief       .
+	 */
+	void stop()
+	{
+		m_running = false;
+		for (auto& thread : m_threads)
+		{
+			if (thread.joinable())
+			{
+				thread.join();
+			}
+		}
+		m_threads.clear();
+	}
+
+	size_t size() const { return m_worlds.size(); }
+	world& at(size_t index) { return *m_worlds.at(index); }
+
+private:
+	using clock = std::chrono::steady_clock;
+
+	size_t m_threadCount;
+	std::vector<std::unique_ptr<world>> m_worlds;
+	std::vector<std::thread> m_threads;
+	std::atomic<bool> m_running = false;
+
+	void run(size_t index, size_t threads, unsigned int tickRate)
+	{
+		auto step = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / std::max(tickRate, 1u)));
+		auto budget = std::chrono::duration_cast<std::chrono::microseconds>(step);
+		float delta_time = 1.0f / std::max(tickRate, 1u);
+
+		auto next = clock::now();
+		clock::duration lag{ 0 };
+		while (m_running)
+		{
+			for (size_t i = index; i < m_worlds.size(); i += threads)
+			{
+				m_worlds[i]->tick(delta_time, budget);
+			}
+
+			next += step;
+			auto now = clock::now();
+			if (now > next)
+			{
+				//        
+				lag += now - next;
+				auto skipped = static_cast<std::uint64_t>(lag / step);
+				lag -= skipped * step;
+				for (size_t i = index; skipped > 0 && i < m_worlds.size(); i += threads)
+				{
+					m_worlds[i]->skipped(skipped);
+				}
+				next = now;
+				continue;
+			}
+			std::this_thread::sleep_until(next);
+		}
+	}
+};
+} // namespace ecs
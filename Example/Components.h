@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../ECS/ecs.hpp"
+
+// components shared by the game and the load test, no SFML here
+struct Velocity
+{
+	float vx, vy;
+};
+struct Position
+{
+	Position(float x, float y)
+		: x(x)
+		, y(y)
+	{
+	}
+
+	float x, y;
+};
+struct Input
+{
+	bool moveLeft = false;
+	bool moveRight = false;
+	bool moveUp = false;
+	bool moveDown = false;
+};
+template <>
+struct ecs::component_storage<Input>
+{
+	static constexpr ecs::storage_policy policy = ecs::storage_policy::sparse;
+};
+
+// systems
+inline void Move(ecs::context& ctx, Position& p, Velocity& v)
+{
+	p.x += v.vx * ctx.delta_time;
+	p.y += v.vy * ctx.delta_time;
+}
+
+inline void HandleInput(Input& input, Velocity& v)
+{
+	v.vx = 0.f;
+	v.vy = 0.f;
+
+	if (input.moveLeft)
+		v.vx -= 500.f;
+	if (input.moveRight)
+		v.vx += 500.f;
+	if (input.moveUp)
+		v.vy -= 500.f;
+	if (input.moveDown)
+		v.vy += 500.f;
+}
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "../ECS/ecs.hpp"
+#include "Components.h"
 #include "SFML/Graphics.hpp"
+#include <algorithm>
 #include <iostream>
+#include <tuple>
+#include <vector>
 
 // scopes
 struct render
@@ -10,25 +14,6 @@ struct render
 };
 
 // components
-struct Velocity
-{
-	float vx, vy;
-};
-struct Position
-{
-	Position(float x, float y)
-		: x(x)
-		, y(y)
-	{
-	}
-	Position(sf::Vector2f position)
-		: x(position.x)
-		, y(position.y)
-	{
-	}
-
-	float x, y;
-};
 struct Renderable
 {
 	Renderable(sf::Color color)
@@ -38,65 +23,92 @@ struct Renderable
 	}
 	sf::RectangleShape rect;
 };
-struct Input
+struct CameraTarget
 {
-	bool moveLeft = false;
-	bool moveRight = false;
-	bool moveUp = false;
-	bool moveDown = false;
 };
+
+// resources
 struct Camera
 {
 	sf::View& camera;
-	sf::RenderWindow& window;
 };
-struct Window
+
+// render snapshot, filled by the simulation and drawn one frame later
+struct RenderState
 {
-	sf::RenderWindow& window;
+	struct Sprite
+	{
+		sf::Vector2f position;
+		sf::Vector2f size;
+		sf::Color color;
+	};
+
+	std::vector<Sprite> sprites;
+	sf::View view;
+};
+
+// events
+struct KeyEvent : ecs::event
+{
+	int code = 0;
+	bool pressed = false;
+
+	// fields written to replay files
+	auto fields() { return std::tie(code, pressed); }
 };
 
 // systems
-void Draw(ecs::context& ctx, Window& w)
+void Extract(ecs::context& ctx, RenderState& state)
 {
+	state.sprites.clear();
 	for (auto& entity : ctx.entity().at_scope<render>().all())
 	{
 		auto pos = entity->get<Position>();
 		auto rect = entity->get<Renderable>();
 		if (pos && rect)
 		{
-			rect->rect.setPosition(pos->x, pos->y);
-			w.window.draw(rect->rect);
+			state.sprites.push_back({ { pos->x, pos->y }, rect->rect.getSize(), rect->rect.getFillColor() });
 		}
 	}
-}
 
-void Move(ecs::context& ctx, Position& p, Velocity& v)
-{
-	p.x += v.vx * ctx.delta_time;
-	p.y += v.vy * ctx.delta_time;
+	std::stable_sort(state.sprites.begin(), state.sprites.end(),
+		[](const auto& lhs, const auto& rhs) { return lhs.position.y < rhs.position.y; });
+	state.view = ctx.resource<Camera>().camera;
 }
 
-void HandleInput(Input& input, Velocity& v)
+void ApplyKey(Input& input, const KeyEvent& key)
 {
-	v.vx = 0.f;
-	v.vy = 0.f;
-
-	if (input.moveLeft)
-		v.vx -= 500.f;
-	if (input.moveRight)
-		v.vx += 500.f;
-	if (input.moveUp)
-		v.vy -= 500.f;
-	if (input.moveDown)
-		v.vy += 500.f;
+	if (key.code == sf::Keyboard::A)
+		input.moveLeft = key.pressed;
+	if (key.code == sf::Keyboard::D)
+		input.moveRight = key.pressed;
+	if (key.code == sf::Keyboard::W)
+		input.moveUp = key.pressed;
+	if (key.code == sf::Keyboard::S)
+		input.moveDown = key.pressed;
 }
 
-void MoveCamera(Camera& c, Position& p)
+void MoveCamera(ecs::context& ctx, CameraTarget&, Position& p)
 {
 	auto pos = sf::Vector2f(p.x, p.y);
-	auto& camera = c.camera;
+	auto& camera = ctx.resource<Camera>().camera;
 	camera.setCenter(camera.getCenter() + (pos - camera.getCenter()) * 0.01f);
-	c.window.setView(camera);
+}
+
+// rendering, runs on the main thread
+void Render(sf::RenderWindow& window, const RenderState& state)
+{
+	sf::RectangleShape rect;
+	window.clear();
+	window.setView(state.view);
+	for (const auto& sprite : state.sprites)
+	{
+		rect.setPosition(sprite.position);
+		rect.setSize(sprite.size);
+		rect.setFillColor(sprite.color);
+		window.draw(rect);
+	}
+	window.display();
 }
 
 class A
@@ -125,6 +137,8 @@ public:
 		ecs::entity_manager em;
 		ecs::system_manager sm(em);
 		ecs::looper looper(sm);
+		ecs::frame_pipeline<RenderState> pipeline(looper);
+		ecs::transform_propagation<Position> transformPropagation;
 		A a;
 
 		sf::RenderWindow window(sf::VideoMode::getDesktopMode(), "ECS Example");
@@ -132,30 +146,47 @@ public:
 		sf::Event event{};
 		sf::Clock clock;
 
+		auto center = static_cast<sf::Vector2f>(window.getSize() / 2u);
 		auto& playerEntity = em.at_scope<render>()
 								 .create()
 								 .add<Velocity>(0.f, 0.f)
-								 .add<Position>(static_cast<sf::Vector2f>(window.getSize() / 2u))
+								 .add<Position>(center.x, center.y)
 								 .add<Renderable>(sf::Color::Green)
-								 .add<Camera>(camera, window)
+								 .add<CameraTarget>()
 								 .add<Input>();
 
-		// create entity in default scope
-		em.create()
-			.add<Window>(window);
-
+		// segment that follows the player
 		em.at_scope<render>()
 			.create()
-			.add<Position>(100.f, 100.f)
+			.add<Position>(0.f, 0.f)
+			.add<ecs::offset>(-60.f, 0.f)
+			.add<Renderable>(sf::Color::Yellow)
+			.child_of(playerEntity);
+
+		sm.event_bus().subscribe<KeyEvent>([&playerEntity](const KeyEvent& key) {
+			ApplyKey(*playerEntity.get<Input>(), key);
+		});
+
+		sm.context().set_resource<Camera>(camera);
+
+		ecs::prefab food;
+		food.add<Position>(0.f, 0.f)
 			.add<Renderable>(sf::Color::Red);
 
-		sm.system<Window>("Draw")
-			.each(Draw, true);
+		auto [foodBegin, foodEnd] = em.at_scope<render>().instantiate(food, 20);
+		for (auto it = foodBegin; it != foodEnd; ++it)
+		{
+			auto index = static_cast<float>(it - foodBegin);
+			*it->get<Position>() = Position(100.f + index * 80.f, 100.f);
+		}
 
 		sm.system<Position>("DoWithContext")
+			.interval(60)
 			.each(&A::DoWithContext, a, true);
 
 		sm.system<Position>("DoWithoutContext")
+			.interval(60)
+			.budget(1)
 			.each(&A::DoWithoutContext, a);
 
 		sm.system<Position, Velocity>("Move")
@@ -164,8 +195,14 @@ public:
 		sm.system<Input, Velocity>("HandleInput")
 			.each(HandleInput);
 
-		sm.system<Camera, Position>("MoveCamera")
-			.each(MoveCamera);
+		sm.system<>("TransformPropagation")
+			.each(&ecs::transform_propagation<Position>::update, transformPropagation, true);
+
+		sm.system<CameraTarget, Position>("MoveCamera")
+			.each(MoveCamera, true);
+
+		sm.system<>("Extract")
+			.each([&pipeline](ecs::context& ctx) { Extract(ctx, pipeline.back()); }, true);
 
 		while (window.isOpen())
 		{
@@ -173,34 +210,18 @@ public:
 			{
 				if (event.type == sf::Event::Closed)
 					window.close();
-				if (event.type == sf::Event::KeyPressed)
-				{
-					if (event.key.code == sf::Keyboard::A)
-						playerEntity.get<Input>()->moveLeft = true;
-					if (event.key.code == sf::Keyboard::D)
-						playerEntity.get<Input>()->moveRight = true;
-					if (event.key.code == sf::Keyboard::W)
-						playerEntity.get<Input>()->moveUp = true;
-					if (event.key.code == sf::Keyboard::S)
-						playerEntity.get<Input>()->moveDown = true;
-				}
-				if (event.type == sf::Event::KeyReleased)
+				if (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased)
 				{
-					if (event.key.code == sf::Keyboard::A)
-						playerEntity.get<Input>()->moveLeft = false;
-					if (event.key.code == sf::Keyboard::D)
-						playerEntity.get<Input>()->moveRight = false;
-					if (event.key.code == sf::Keyboard::W)
-						playerEntity.get<Input>()->moveUp = false;
-					if (event.key.code == sf::Keyboard::S)
-						playerEntity.get<Input>()->moveDown = false;
+					KeyEvent key;
+					key.code = event.key.code;
+					key.pressed = event.type == sf::Event::KeyPressed;
+					sm.event_bus().publish(key);
 				}
 			}
 
+			// simulates the next frame on a worker thread while this one is drawn
 			float dt = clock.restart().asSeconds();
-			window.clear();
-			looper.frame(dt);
-			window.display();
+			pipeline.frame(dt, [&window](const RenderState& state) { Render(window, state); });
 		}
 	}
 };
@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "../ECS/ecs.hpp"
+#include "../Example/Components.h"
+
+namespace
+{
+struct Options
+{
+	size_t bots = 2000;
+	double seconds = 10;
+	unsigned int tickRate = 60;
+	double churn = 50;
+	bool defragment = false;
+	double maxP99 = 0;
+};
+
+/**
+ * @brief   .
+ */
+enum class Script
+{
+	wander,
+	circle,
+	strafe,
+};
+
+struct Bot
+{
+	Script script;
+	size_t step = 0;
+	size_t nextChange = 0;
+	std::uint32_t seed;
+};
+
+/**
+ * @brief  ,    ,     .
+ */
+struct BotCommand : ecs::event
+{
+	size_t entity = 0;
+	Input input;
+};
+
+struct Stats
+{
+	size_t events = 0;
+	size_t spawned = 0;
+	size_t destroyed = 0;
+	size_t slots = 0;
+};
+
+void PrintUsage()
+{
+	std::cout << "usage: load_test [--bots N] [--seconds S] [--tick-rate HZ (0 = unlimited)]\n"
+				 "                 [--churn PER_SECOND] [--defragment] [--max-p99-ms MS]\n";
+}
+
+/**
+ * @brief     ,      .
+ */
+bool ParseNumber(const std::string& text, double min, double max, double& value)
+{
+	try
+	{
+		size_t length = 0;
+		value = std::stod(text, &length);
+		return length == text.size() && value >= min && value <= max;
+	}
+	catch (const std::exception&)
+	{
+		return false;
+	}
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string name = argv[i];
+		if (name == "--defragment")
+		{
+			options.defragment = true;
+			continue;
+		}
+		if (i + 1 >= argc)
+		{
+			return false;
+		}
+
+		double value = 0;
+		std::string text = argv[++i];
+		if (name == "--bots" && ParseNumber(text, 0, 10000000, value))
+			options.bots = static_cast<size_t>(value);
+		else if (name == "--seconds" && ParseNumber(text, 0.001, 86400, value))
+			options.seconds = value;
+		else if (name == "--tick-rate" && ParseNumber(text, 0, 100000, value))
+			options.tickRate = static_cast<unsigned int>(value);
+		else if (name == "--churn" && ParseNumber(text, 0, 10000000, value))
+			options.churn = value;
+		else if (name == "--max-p99-ms" && ParseNumber(text, 0, 86400000, value))
+			options.maxP99 = value;
+		else
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief       .
+ */
+size_t ResidentBytes()
+{
+	std::ifstream statm("/proc/self/statm");
+	size_t total = 0;
+	size_t resident = 0;
+	statm >> total >> resident;
+	return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+Input Steer(Bot& bot)
+{
+	Input input;
+	switch (bot.script)
+	{
+	case Script::wander:
+	{
+		bot.seed = bot.seed * 1664525u + 1013904223u;
+		input.moveLeft = bot.seed & 1;
+		input.moveRight = bot.seed & 2;
+		input.moveUp = bot.seed & 4;
+		input.moveDown = bot.seed & 8;
+		break;
+	}
+	case Script::circle:
+		input.moveRight = bot.step % 4 == 0;
+		input.moveDown = bot.step % 4 == 1;
+		input.moveLeft = bot.step % 4 == 2;
+		input.moveUp = bot.step % 4 == 3;
+		break;
+	case Script::strafe:
+		input.moveLeft = bot.step % 2 == 0;
+		input.moveRight = bot.step % 2 == 1;
+		break;
+	}
+	++bot.step;
+	return input;
+}
+
+void Drive(ecs::context& ctx, Bot& bot)
+{
+	if (ctx.tick < bot.nextChange)
+	{
+		return;
+	}
+	bot.nextChange = ctx.tick + 15 + bot.seed % 45;
+
+	BotCommand command;
+	command.entity = ctx.entity_id;
+	command.input = Steer(bot);
+	ctx.event_bus().publish(command);
+}
+
+size_t Spawn(ecs::entity_manager& em, std::mt19937& random)
+{
+	std::uniform_real_distribution<float> coord(0.f, 10000.f);
+	auto& e = em.create()
+				  .add<Position>(coord(random), coord(random))
+				  .add<Velocity>(0.f, 0.f)
+				  .add<Input>()
+				  .add<Bot>(static_cast<Script>(random() % 3), 0, 0, static_cast<std::uint32_t>(random()));
+	return e.ID();
+}
+
+double Percentile(const std::vector<double>& sorted, double p)
+{
+	if (sorted.empty())
+	{
+		return 0;
+	}
+	auto index = static_cast<size_t>(p * (sorted.size() - 1));
+	return sorted[index];
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	ecs::entity_manager em;
+	ecs::system_manager sm(em);
+	ecs::looper looper(sm);
+	std::mt19937 random(12345);
+	Stats stats;
+
+	std::vector<size_t> bots;
+	for (size_t i = 0; i < options.bots; ++i)
+	{
+		bots.push_back(Spawn(em, random));
+	}
+	stats.slots = bots.empty() ? 0 : bots.back() + 1;
+
+	sm.event_bus().subscribe<BotCommand>([&em, &stats](const BotCommand& command) {
+		++stats.events;
+		if (auto e = em.get(command.entity))
+		{
+			if (auto input = e->get<Input>())
+			{
+				*input = command.input;
+			}
+		}
+	});
+
+	// replaces a fraction of the bots every tick, as players leave and join
+	double churnDebt = 0;
+	sm.system<>("Churn").each([&](ecs::context& ctx) {
+		churnDebt += options.churn * ctx.delta_time;
+		auto count = std::min(static_cast<size_t>(churnDebt), bots.size());
+		churnDebt -= static_cast<double>(count);
+		if (count == 0)
+		{
+			return;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto index = random() % bots.size();
+			em.get(bots[index])->destruct();
+			bots[index] = bots.back();
+			bots.pop_back();
+		}
+		em.invalidate();
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto ID = Spawn(em, random);
+			bots.push_back(ID);
+			stats.slots = std::max(stats.slots, ID + 1);
+		}
+		stats.destroyed += count;
+		stats.spawned += count;
+	},
+		true);
+
+	ecs::defragmenter<Position, Velocity> defragmenter(ecs::morton_key<Position>(64.f), 1000);
+	if (options.defragment)
+	{
+		sm.system<>("Defragment")
+			.each(&ecs::defragmenter<Position, Velocity>::update, defragmenter, true);
+	}
+
+	sm.system<Bot>("Drive").each(Drive, true);
+	sm.system<Input, Velocity>("HandleInput").each(HandleInput);
+	sm.system<Position, Velocity>("Move").each(Move, true);
+
+	using clock = std::chrono::steady_clock;
+	auto step = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / std::max(options.tickRate, 1u)));
+	std::vector<double> tickMs;
+	size_t overruns = 0;
+
+	auto rssStart = ResidentBytes();
+	auto rssPeak = rssStart;
+	auto start = clock::now();
+	auto end = start + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(options.seconds));
+	auto next = start;
+	auto previousStart = start;
+	while (clock::now() < end)
+	{
+		// without a tick rate the simulation advances by the measured time of the previous tick
+		auto tickStart = clock::now();
+		auto delta_time = options.tickRate > 0
+			? 1.0f / options.tickRate
+			: std::chrono::duration<float>(tickStart - previousStart).count();
+		previousStart = tickStart;
+		looper.frame(delta_time);
+		auto elapsed = clock::now() - tickStart;
+		tickMs.push_back(std::chrono::duration<double, std::milli>(elapsed).count());
+
+		if (tickMs.size() % 64 == 0)
+		{
+			rssPeak = std::max(rssPeak, ResidentBytes());
+		}
+
+		if (options.tickRate == 0)
+			continue;
+
+		if (elapsed > step)
+		{
+			++overruns;
+		}
+		next += step;
+		auto now = clock::now();
+		if (now > next)
+		{
+			next = now;
+			continue;
+		}
+		std::this_thread::sleep_until(next);
+	}
+	std::chrono::duration<double> wall = clock::now() - start;
+	auto rssEnd = ResidentBytes();
+	rssPeak = std::max(rssPeak, rssEnd);
+
+	auto sorted = tickMs;
+	std::sort(sorted.begin(), sorted.end());
+	auto p99 = Percentile(sorted, 0.99);
+	constexpr double MiB = 1024.0 * 1024.0;
+
+	std::cout << "bots:               " << options.bots << (options.defragment ? " (defragmented)" : "") << '\n'
+			  << "ticks:              " << tickMs.size() << " in " << wall.count() << " s\n"
+			  << "tick ms p50/p90/p99/max: " << Percentile(sorted, 0.5) << " / " << Percentile(sorted, 0.9)
+			  << " / " << p99 << " / " << (sorted.empty() ? 0 : sorted.back()) << '\n'
+			  << "overruns:           " << overruns << '\n'
+			  << "rss MiB start/end/peak: " << rssStart / MiB << " / " << rssEnd / MiB << " / " << rssPeak / MiB << '\n'
+			  << "rss growth MiB/min: " << (static_cast<double>(rssEnd) - static_cast<double>(rssStart)) / MiB / wall.count() * 60 << '\n'
+			  << "entity slots:       " << stats.slots << " for " << bots.size() << " alive\n"
+			  << "churn per second:   " << stats.spawned / wall.count() << " (bots replaced)\n"
+			  << "events per second:  " << stats.events / wall.count() << '\n';
+
+	if (options.maxP99 > 0 && p99 > options.maxP99)
+	{
+		std::cout << "FAIL: p99 tick " << p99 << " ms exceeds " << options.maxP99 << " ms\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}